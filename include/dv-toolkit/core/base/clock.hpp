@@ -0,0 +1,186 @@
+#pragma once
+
+#include "./trigger.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace dv::toolkit {
+
+/**
+ * @brief Affine mapping from the clock of one camera to a common time base,
+ * `common = local + offset + drift * (local - pivot)`. The pivot keeps the
+ * model numerically stable for absolute microsecond timestamps.
+ */
+struct ClockModel {
+	/** Common minus local time at the pivot, in microseconds */
+	double offset{0.};
+	/** Relative rate error of the local clock, 1e-6 means 1us per second */
+	double drift{0.};
+	int64_t pivot{0};
+
+	[[nodiscard]] int64_t toCommon(const int64_t local) const noexcept {
+		return local + static_cast<int64_t>(std::llround(offset + drift * static_cast<double>(local - pivot)));
+	}
+
+	/**
+	 * @brief Earliest local time whose common time is at or after `common`.
+	 */
+	[[nodiscard]] int64_t toLocal(const int64_t common) const noexcept {
+		const double local = static_cast<double>(common - pivot) - offset;
+		return pivot + static_cast<int64_t>(std::ceil(local / (1. + drift)));
+	}
+
+	[[nodiscard]] bool isIdentity() const noexcept {
+		return offset == 0. && drift == 0.;
+	}
+
+	/**
+	 * @brief Estimate the clock of a camera from triggers it shares with the
+	 * reference camera. Triggers are paired with their nearest counterpart and
+	 * the model is fitted by least squares, unpaired triggers on either side
+	 * are ignored.
+	 *
+	 * @param reference 	Triggers timestamped by the reference clock
+	 * @param local 		The same triggers timestamped by the local clock
+	 * @param maxDeviation 	Largest distance of a pair after the initial alignment,
+	 * 						defaults to half the median
+	 * 						reference trigger period
+	 */
+	[[nodiscard]] static ClockModel estimate(
+		const TriggerStorage &reference, const TriggerStorage &local, const int64_t maxDeviation = -1) {
+		if (reference.isEmpty() || local.isEmpty()) {
+			throw std::invalid_argument("Clock estimation requires triggers from both cameras");
+		}
+
+		std::vector<int64_t> referenceTimes;
+		referenceTimes.reserve(reference.size());
+		for (const auto &trigger : reference) {
+			referenceTimes.push_back(trigger.timestamp);
+		}
+		std::vector<int64_t> localTimes;
+		localTimes.reserve(local.size());
+		for (const auto &trigger : local) {
+			localTimes.push_back(trigger.timestamp);
+		}
+
+		double tolerance = static_cast<double>(maxDeviation);
+		if (maxDeviation <= 0) {
+			if (referenceTimes.size() < 2) {
+				tolerance = std::numeric_limits<double>::infinity();
+			} else {
+				std::vector<int64_t> periods(referenceTimes.size() - 1);
+				for (size_t i = 1; i < referenceTimes.size(); i++) {
+					periods[i - 1] = referenceTimes[i] - referenceTimes[i - 1];
+				}
+				std::nth_element(periods.begin(), periods.begin() + periods.size() / 2, periods.end());
+				tolerance = static_cast<double>(std::max<int64_t>(1, periods[periods.size() / 2] / 2));
+			}
+		}
+
+		// Either side may have missed its first triggers, so the initial alignment
+		// is the pairing among the first few triggers of each side that leaves the
+		// smallest median distance, ties are broken by the number of pairs
+		ClockModel model;
+		model.pivot         = localTimes.front();
+		double bestDistance = std::numeric_limits<double>::infinity();
+		size_t bestMatches  = 0;
+		const size_t candidates = 4;
+		for (size_t i = 0; i < std::min(candidates, referenceTimes.size()); i++) {
+			for (size_t j = 0; j < std::min(candidates, localTimes.size()); j++) {
+				ClockModel candidate;
+				candidate.pivot  = localTimes.front();
+				candidate.offset = static_cast<double>(referenceTimes[i] - localTimes[j]);
+
+				const auto pairs = match(referenceTimes, localTimes, candidate, tolerance);
+				if (pairs.empty()) {
+					continue;
+				}
+				const double distance = medianDistance(candidate, pairs);
+				if (distance < bestDistance || (distance == bestDistance && pairs.size() > bestMatches)) {
+					bestDistance = distance;
+					bestMatches  = pairs.size();
+					model        = candidate;
+				}
+			}
+		}
+
+		// Later passes match against the fitted model, which corrects drift, with a
+		// tolerance tightened to the spread of the fit. This rejects triggers paired
+		// with a neighbour of a trigger the other camera missed
+		for (int pass = 0; pass < 3; pass++) {
+			const auto pairs = match(referenceTimes, localTimes, model, tolerance);
+			if (pairs.empty()) {
+				throw std::runtime_error("No shared triggers found between the cameras");
+			}
+			model     = fit(pairs);
+			tolerance = std::min(tolerance, std::max(2., 4. * medianDistance(model, pairs)));
+		}
+		return model;
+	}
+
+private:
+	[[nodiscard]] static double medianDistance(const ClockModel &model, const std::vector<std::pair<int64_t, int64_t>> &pairs) {
+		std::vector<double> distances;
+		distances.reserve(pairs.size());
+		for (const auto &[referenceTime, localTime] : pairs) {
+			distances.push_back(std::abs(static_cast<double>(model.toCommon(localTime) - referenceTime)));
+		}
+		std::nth_element(distances.begin(), distances.begin() + static_cast<ptrdiff_t>(distances.size() / 2), distances.end());
+		return distances[distances.size() / 2];
+	}
+
+	[[nodiscard]] static std::vector<std::pair<int64_t, int64_t>> match(const std::vector<int64_t> &referenceTimes,
+		const std::vector<int64_t> &localTimes, const ClockModel &model, const double tolerance) {
+		std::vector<std::pair<int64_t, int64_t>> pairs;
+		auto lower = referenceTimes.begin();
+		for (const auto localTime : localTimes) {
+			const int64_t common = model.toCommon(localTime);
+			lower                = std::lower_bound(lower, referenceTimes.end(), common);
+
+			auto nearest = lower;
+			if (lower == referenceTimes.end() || (lower != referenceTimes.begin() && common - *(lower - 1) < *lower - common)) {
+				nearest = lower - 1;
+			}
+			if (static_cast<double>(std::abs(*nearest - common)) <= tolerance) {
+				pairs.emplace_back(*nearest, localTime);
+			}
+		}
+		return pairs;
+	}
+
+	[[nodiscard]] static ClockModel fit(const std::vector<std::pair<int64_t, int64_t>> &pairs) {
+		// Sums are taken relative to the first pair to avoid precision loss
+		const auto [referenceOrigin, localOrigin] = pairs.front();
+		double meanReference = 0.;
+		double meanLocal     = 0.;
+		for (const auto &[referenceTime, localTime] : pairs) {
+			meanReference += static_cast<double>(referenceTime - referenceOrigin);
+			meanLocal     += static_cast<double>(localTime - localOrigin);
+		}
+		meanReference /= static_cast<double>(pairs.size());
+		meanLocal     /= static_cast<double>(pairs.size());
+
+		double covariance = 0.;
+		double variance   = 0.;
+		for (const auto &[referenceTime, localTime] : pairs) {
+			const double dl = static_cast<double>(localTime - localOrigin) - meanLocal;
+			const double dr = static_cast<double>(referenceTime - referenceOrigin) - meanReference;
+			covariance     += dl * dr;
+			variance       += dl * dl;
+		}
+
+		ClockModel model;
+		model.pivot  = localOrigin + static_cast<int64_t>(std::llround(meanLocal));
+		const double pivotShift = static_cast<double>(model.pivot - localOrigin) - meanLocal;
+		const double rate       = (variance > 0.) ? covariance / variance : 1.;
+		model.drift  = rate - 1.;
+		model.offset = static_cast<double>(referenceOrigin - localOrigin) + meanReference + rate * pivotShift
+					 - static_cast<double>(model.pivot - localOrigin);
+		return model;
+	}
+};
+
+} // namespace dv::toolkit
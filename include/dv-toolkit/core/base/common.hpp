@@ -3,12 +3,16 @@
 #include <algorithm>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <numeric>
 #include <optional>
+#include <type_traits>
 #include <vector>
 
+#include "./spill.hpp"
+
 #include <dv-processing/core/concepts.hpp>
 #include <dv-processing/core/dvassert.hpp>
 #include <dv-processing/core/time.hpp>
@@ -88,7 +92,7 @@ public:
  */
 template<typename Type, class PacketType>
 class PartialData {
-    using iterator = typename std::vector<Type>::const_iterator;
+    using iterator = const Type *;
     
 private:
 	bool referencesConstData_;
@@ -99,6 +103,14 @@ private:
 	int64_t highestTime_;
 	std::shared_ptr<PacketType> modifiableDataPtr_;
 	std::shared_ptr<const PacketType> data_;
+	/** Elements living outside of a packet, e.g. in mapped memory, nullptr otherwise */
+	const Type *view_{nullptr};
+	/** Keeps the memory behind view_ alive */
+	std::shared_ptr<const void> viewOwner_;
+
+	[[nodiscard]] inline const Type *elements() const noexcept {
+		return (view_ != nullptr) ? view_ : data_->elements.data();
+	}
 
 public:
 	explicit PartialData(const size_t capacity = 10000) :
@@ -129,6 +141,53 @@ public:
 		}
 	}
 
+	/**
+	 * @brief Reference `length` elements owned by someone else without copying
+	 * them. The shard is read-only and holds `owner` for as long as it or any
+	 * slice of it is alive.
+	 */
+	PartialData(const Type *elements, const size_t length, std::shared_ptr<const void> owner) :
+		referencesConstData_(true),
+		start_(0),
+		length_(length),
+		capacity_(length),
+		lowestTime_(0),
+		highestTime_(0),
+		modifiableDataPtr_(nullptr),
+		data_(nullptr),
+		view_(elements),
+		viewOwner_(std::move(owner)) {
+		if (length_ == 0) {
+			return;
+		}
+
+		if constexpr (dv::concepts::TimestampedByAccessor<Type>) {
+			lowestTime_  = elements[0].timestamp();
+			highestTime_ = elements[length_ - 1].timestamp();
+		} else {
+			lowestTime_  = elements[0].timestamp;
+			highestTime_ = elements[length_ - 1].timestamp;
+		}
+	}
+
+	/**
+	 * @brief Reference external elements whose time range is already known, the
+	 * elements themselves are not touched.
+	 */
+	PartialData(const Type *elements, const size_t length, std::shared_ptr<const void> owner, const int64_t lowestTime,
+		const int64_t highestTime) :
+		referencesConstData_(true),
+		start_(0),
+		length_(length),
+		capacity_(length),
+		lowestTime_(lowestTime),
+		highestTime_(highestTime),
+		modifiableDataPtr_(nullptr),
+		data_(nullptr),
+		view_(elements),
+		viewOwner_(std::move(owner)) {
+	}
+
     PartialData(const PartialData &other) = default;
 
 	iterator iteratorAtTime(const int64_t time) const {
@@ -138,11 +197,11 @@ public:
 	}
 
 	iterator begin() const {
-		return data_->elements.begin() + start_;
+		return elements() + start_;
 	}
 
 	iterator end() const {
-		return data_->elements.begin() + start_ + length_;
+		return elements() + start_ + length_;
 	}
 
 	void sliceFront(const size_t number) {
@@ -153,9 +212,9 @@ public:
 		start_      = start_ + number;
 		length_     = length_ - number;
 		if constexpr (dv::concepts::TimestampedByAccessor<Type>) {
-			lowestTime_ = (length_ == 0) ? (0) : (data_->elements)[start_].timestamp();
+			lowestTime_ = (length_ == 0) ? (0) : elements()[start_].timestamp();
 		} else {
-			lowestTime_ = (length_ == 0) ? (0) : (data_->elements)[start_].timestamp;
+			lowestTime_ = (length_ == 0) ? (0) : elements()[start_].timestamp;
 		}
 	}
 
@@ -166,9 +225,9 @@ public:
 
 		length_      = length_ - number;
 		if constexpr (dv::concepts::TimestampedByAccessor<Type>) {
-			highestTime_ = (length_ == 0) ? (0) : (data_->elements)[start_ + length_ - 1].timestamp();
+			highestTime_ = (length_ == 0) ? (0) : elements()[start_ + length_ - 1].timestamp();
 		} else {
-			highestTime_ = (length_ == 0) ? (0) : (data_->elements)[start_ + length_ - 1].timestamp;
+			highestTime_ = (length_ == 0) ? (0) : elements()[start_ + length_ - 1].timestamp;
 		}
 	}
 
@@ -244,7 +303,14 @@ public:
 
 	[[nodiscard]] inline const Type &operator[](size_t offset) const {
 		dv::runtime_assert([&] { return offset <= length_; }, [] { return "offset out of bounds"; });
-		return (data_->elements)[start_ + offset];
+		return elements()[start_ + offset];
+	}
+
+	/**
+	 * @brief Whether the elements live outside of a packet, e.g. in mapped memory.
+	 */
+	[[nodiscard]] inline bool isView() const noexcept {
+		return view_ != nullptr;
 	}
 
 	[[nodiscard]] inline bool canStoreMore() const {
@@ -271,15 +337,13 @@ public:
 			return true;
 		}
 
-		if constexpr (dv::concepts::TimestampedByAccessor<Type>) {
-			highestTime_ = back().timestamp();
-		} else {
-			highestTime_ = back().timestamp;
-		}
-
 		// Actual merge
-		modifiableDataPtr_->elements.insert(end(), other.begin(), other.end());
+		modifiableDataPtr_->elements.insert(modifiableDataPtr_->elements.end(), other.begin(), other.end());
 		length_      += other.length_;
+		highestTime_  = other.getHighestTime();
+		if (length_ == other.length_) {
+			lowestTime_ = other.getLowestTime();
+		}
 		return true;
 	}
 };
@@ -310,6 +374,19 @@ public:
 };
 
 
+/**
+ * @brief Read position inside an addressable storage, expressed as the shard
+ * it points to plus the offset within that shard. A cursor stays valid while
+ * elements are appended to the storage, it only has to be rebased when shards
+ * in front of it are released.
+ */
+struct StorageCursor {
+	/** The current partial (shard) we point to */
+	size_t partialIndex{0};
+	/** The current offset inside the shard we point to */
+	size_t offset{0};
+};
+
 /**
  * @brief 
  * 
@@ -469,6 +546,12 @@ protected:
 	size_t totalLength_{0};
 	/** Default capacity for the data partials **/
 	size_t shardCapacity_{10000};
+	/** Scratch file receiving sealed shards beyond the memory budget, out-of-core mode only */
+	std::shared_ptr<SpillFile> spillFile_;
+	/** Bytes of sealed shards kept in memory in out-of-core mode */
+	size_t memoryBudget_{0};
+	/** Shards in front of this index are known to be spilled or mapped */
+	size_t spillIndex_{0};
 
 	explicit AddressableStorage(const std::vector<PartialDataType> &dataPartials) {
 		this->dataPartials_ = dataPartials;
@@ -480,11 +563,61 @@ protected:
 		}
 	}
 
+	/**
+	 * @brief Spill the oldest of the first `sealed` shards until the remaining
+	 * ones fit into the memory budget. Only the resident shards at the back
+	 * are visited, the front is known to be spilled already.
+	 */
+	void _spillSealedPartials(const size_t sealed) {
+		if constexpr (std::is_trivially_copyable_v<Type>) {
+			if (spillFile_ == nullptr) {
+				return;
+			}
+
+			size_t resident = 0;
+			size_t boundary = sealed;
+			while (boundary > spillIndex_) {
+				const auto &partial = dataPartials_[boundary - 1];
+				if (!partial.isView()) {
+					resident += partial.getLength() * sizeof(Type);
+					if (resident > memoryBudget_) {
+						break;
+					}
+				}
+				boundary--;
+			}
+
+			for (; spillIndex_ < boundary; spillIndex_++) {
+				auto &partial = dataPartials_[spillIndex_];
+				if (partial.isView() || partial.getLength() == 0) {
+					continue;
+				}
+
+				// The time range of the shard stays resident, so lookups by time do
+				// not touch the spilled elements
+				const auto spilled = spillFile_->append(&*partial.begin(), partial.getLength() * sizeof(Type));
+				partial = PartialDataType(static_cast<const Type *>(spilled.get()), partial.getLength(), spilled,
+					partial.getLowestTime(), partial.getHighestTime());
+			}
+		}
+	}
+
+	void _addViewPartial(PartialDataType partial) {
+		if (!isEmpty() && getHighestTime() > partial.getLowestTime()) {
+			throw std::out_of_range{"Tried adding elements to store out of order."};
+		}
+
+		partialOffsets_.push_back(totalLength_);
+		totalLength_ += partial.getLength();
+		dataPartials_.push_back(std::move(partial));
+	}
+
 	[[nodiscard]] PartialData<Type, PacketType> &_getLastNonFullPartial() {
 		if (!dataPartials_.empty() && dataPartials_.back().canStoreMore()) {
 			return dataPartials_.back();
 		}
 
+		_spillSealedPartials(dataPartials_.size());
 		partialOffsets_.emplace_back(totalLength_);
 		return dataPartials_.emplace_back(shardCapacity_);
 	}
@@ -540,6 +673,63 @@ public:
 
 			totalLength_ += partial.getLength();
 		}
+
+		_spillSealedPartials(dataPartials_.size() - 1);
+	}
+
+	/**
+	 * @brief Append `length` elements owned by `owner` as a single read-only shard,
+	 * the elements are referenced in place and never copied.
+	 */
+	void addView(const Type *elements, const size_t length, std::shared_ptr<const void> owner) {
+		if (length == 0) {
+			return;
+		}
+		_addViewPartial(PartialDataType(elements, length, std::move(owner)));
+	}
+
+	/**
+	 * @brief Append a read-only shard whose time range is already known, e.g. from
+	 * an index, so the referenced elements are not touched.
+	 */
+	void addView(const Type *elements, const size_t length, std::shared_ptr<const void> owner,
+		const int64_t lowestTime, const int64_t highestTime) {
+		if (length == 0) {
+			return;
+		}
+		_addViewPartial(PartialDataType(elements, length, std::move(owner), lowestTime, highestTime));
+	}
+
+	/**
+	 * @brief Keep at most `memoryBudget` bytes of sealed shards in memory, older
+	 * shards are written to `scratch` and mapped back read-only. Spilled shards
+	 * are reloaded page by page when slicing or iteration touches them and
+	 * evicted again by the page cache, shards shared with other storages are
+	 * only released once none of them references the memory.
+	 */
+	void enableOutOfCore(std::shared_ptr<SpillFile> scratch, const size_t memoryBudget) {
+		static_assert(std::is_trivially_copyable_v<Type>, "Only trivially copyable elements can be spilled");
+		if (scratch == nullptr) {
+			throw std::invalid_argument("Out-of-core mode requires a scratch file");
+		}
+
+		spillFile_    = std::move(scratch);
+		memoryBudget_ = memoryBudget;
+		spillIndex_   = 0;
+		if (!dataPartials_.empty()) {
+			_spillSealedPartials(dataPartials_.size() - 1);
+		}
+	}
+
+	[[nodiscard]] bool isOutOfCore() const noexcept {
+		return spillFile_ != nullptr;
+	}
+
+	/**
+	 * @brief The shards of the storage, each covering a contiguous range of elements.
+	 */
+	[[nodiscard]] const std::vector<PartialDataType> &partials() const noexcept {
+		return dataPartials_;
 	}
 
 	StorageType &operator=(std::shared_ptr<const PacketType> packet) {
@@ -666,6 +856,123 @@ public:
 		return StorageType(newPartials);
 	}
 
+	[[nodiscard]] StorageCursor cursorBegin() const noexcept {
+		return StorageCursor{0, 0};
+	}
+
+	[[nodiscard]] StorageCursor cursorEnd() const noexcept {
+		if (dataPartials_.empty()) {
+			return StorageCursor{0, 0};
+		}
+		return StorageCursor{dataPartials_.size() - 1, dataPartials_.back().getLength()};
+	}
+
+	[[nodiscard]] size_t cursorIndex(const StorageCursor &cursor) const noexcept {
+		if (cursor.partialIndex >= partialOffsets_.size()) {
+			return totalLength_;
+		}
+		return partialOffsets_[cursor.partialIndex] + cursor.offset;
+	}
+
+	[[nodiscard]] const_iterator cursorIterator(const StorageCursor &cursor) const noexcept {
+		if (cursor.partialIndex >= dataPartials_.size()) {
+			return end();
+		}
+		if (cursor.offset >= dataPartials_[cursor.partialIndex].getLength()) {
+			return iterator(&dataPartials_, cursor.partialIndex + 1, 0);
+		}
+		return iterator(&dataPartials_, cursor.partialIndex, cursor.offset);
+	}
+
+	/**
+	 * @brief Move a cursor forward by a number of elements, only the shards that
+	 * are passed over are visited. The cursor is clamped to the end of the storage.
+	 */
+	[[nodiscard]] StorageCursor advanceCursor(StorageCursor cursor, size_t number) const {
+		while (cursor.partialIndex < dataPartials_.size()) {
+			const size_t available = dataPartials_[cursor.partialIndex].getLength() - cursor.offset;
+			if (number <= available || cursor.partialIndex + 1 == dataPartials_.size()) {
+				cursor.offset += std::min(number, available);
+				return cursor;
+			}
+
+			number -= available;
+			cursor.partialIndex++;
+			cursor.offset = 0;
+		}
+		return cursor;
+	}
+
+	/**
+	 * @brief Move a cursor forward to the first element with a timestamp greater
+	 * or equal to the given time. The cursor never moves backwards.
+	 */
+	[[nodiscard]] StorageCursor advanceCursorToTime(StorageCursor cursor, const int64_t time) const {
+		while (cursor.partialIndex < dataPartials_.size()) {
+			const auto &partial = dataPartials_[cursor.partialIndex];
+			if (cursor.offset < partial.getLength() && partial.getHighestTime() >= time) {
+				auto timeItr = std::lower_bound(partial.begin() + static_cast<ptrdiff_t>(cursor.offset), partial.end(),
+					time, TimeComparator<Type>());
+				cursor.offset = static_cast<size_t>(timeItr - partial.begin());
+				return cursor;
+			}
+
+			if (cursor.partialIndex + 1 == dataPartials_.size()) {
+				cursor.offset = partial.getLength();
+				return cursor;
+			}
+
+			cursor.partialIndex++;
+			cursor.offset = 0;
+		}
+		return cursor;
+	}
+
+	/**
+	 * @brief Slice the elements between two cursors without any lookup, the
+	 * returned storage shares the shards of this storage.
+	 */
+	[[nodiscard]] StorageType sliceCursor(const StorageCursor &from, const StorageCursor &to) const {
+		std::vector<PartialDataType> newPartials;
+		for (size_t i = from.partialIndex; i <= to.partialIndex && i < dataPartials_.size(); i++) {
+			const size_t cutFront = (i == from.partialIndex) ? from.offset : 0;
+			const size_t cutBack  = (i == to.partialIndex) ? dataPartials_[i].getLength() - to.offset : 0;
+			if (cutFront + cutBack >= dataPartials_[i].getLength()) {
+				continue;
+			}
+
+			auto &partial = newPartials.emplace_back(dataPartials_[i]);
+			partial.sliceBack(cutBack);
+			partial.sliceFront(cutFront);
+		}
+
+		return StorageType(newPartials);
+	}
+
+	/**
+	 * @brief Drop the given number of shards from the front of the storage. The
+	 * shards stay alive as long as slices are referencing them.
+	 * 
+	 * @return Number of elements released.
+	 */
+	size_t releasePartials(const size_t count) {
+		const size_t number = std::min(count, dataPartials_.size());
+		if (number == 0) {
+			return 0;
+		}
+
+		const size_t released = (number < partialOffsets_.size()) ? partialOffsets_[number] : totalLength_;
+		dataPartials_.erase(dataPartials_.begin(), dataPartials_.begin() + static_cast<ptrdiff_t>(number));
+		partialOffsets_.erase(partialOffsets_.begin(), partialOffsets_.begin() + static_cast<ptrdiff_t>(number));
+		for (auto &offset : partialOffsets_) {
+			offset -= released;
+		}
+		totalLength_ -= released;
+		spillIndex_   = spillIndex_ - std::min(spillIndex_, number);
+
+		return released;
+	}
+
 	[[nodiscard]] StorageType downSample(const size_t factor) {
 		if (totalLength_ == 0) {
 			return StorageType();
@@ -847,6 +1154,7 @@ public:
 		}
 
 		// Rebuild the partials offset LUT
+		spillIndex_ = 0;
 		partialOffsets_.erase(lowerPartial, partialOffsets_.end());
 		totalLength_ = partialOffsets_.back();
 
@@ -931,6 +1239,7 @@ public:
 
 		if (lowerPartial != dataPartials_.begin()) {
 			dataPartials_.erase(dataPartials_.begin(), --lowerPartial);
+			spillIndex_ = 0;
 			partialOffsets_.clear();
 			partialOffsets_.reserve(dataPartials_.size());
 			totalLength_ = 0;
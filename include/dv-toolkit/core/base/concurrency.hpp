@@ -0,0 +1,281 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace dv::toolkit {
+
+/**
+ * @brief Fixed size pool of worker threads executing posted tasks in FIFO
+ * order. Pending tasks are still executed when the pool is destroyed.
+ */
+class ThreadPool {
+private:
+	std::vector<std::thread> mWorkers;
+	std::deque<std::function<void()>> mTasks;
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	bool mStopping = false;
+
+	/** Pool whose worker runs on the current thread, nullptr on other threads */
+	static inline thread_local const ThreadPool *sCurrentPool = nullptr;
+
+	void work() {
+		sCurrentPool = this;
+		while (true) {
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mCondition.wait(lock, [this] {
+					return mStopping || !mTasks.empty();
+				});
+
+				if (mTasks.empty()) {
+					return;
+				}
+
+				task = std::move(mTasks.front());
+				mTasks.pop_front();
+			}
+			task();
+		}
+	}
+
+public:
+	explicit ThreadPool(const size_t numThreads = std::thread::hardware_concurrency()) {
+		const size_t count = std::max<size_t>(1, numThreads);
+		mWorkers.reserve(count);
+		for (size_t i = 0; i < count; i++) {
+			mWorkers.emplace_back([this] {
+				work();
+			});
+		}
+	}
+
+	ThreadPool(const ThreadPool &other) = delete;
+	ThreadPool &operator=(const ThreadPool &other) = delete;
+
+	~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStopping = true;
+		}
+		mCondition.notify_all();
+
+		for (auto &worker : mWorkers) {
+			worker.join();
+		}
+	}
+
+	void post(std::function<void()> task) {
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mTasks.push_back(std::move(task));
+		}
+		mCondition.notify_one();
+	}
+
+	template<class Function>
+	[[nodiscard]] std::future<std::invoke_result_t<Function>> submit(Function &&function) {
+		using ResultType = std::invoke_result_t<Function>;
+
+		auto task   = std::make_shared<std::packaged_task<ResultType()>>(std::forward<Function>(function));
+		auto future = task->get_future();
+		post([task] {
+			(*task)();
+		});
+		return future;
+	}
+
+	[[nodiscard]] size_t size() const noexcept {
+		return mWorkers.size();
+	}
+
+	/**
+	 * @brief Whether the calling thread is a worker of this pool. A task waiting on
+	 * futures of its own pool can starve it, such callers have to run the work
+	 * themselves instead.
+	 */
+	[[nodiscard]] bool ownsCurrentThread() const noexcept {
+		return sCurrentPool == this;
+	}
+};
+
+/**
+ * @brief Blocking FIFO queue holding at most `capacity` elements, producers
+ * wait while it is full and consumers while it is empty. Once closed, pushes
+ * are rejected and pops drain the remaining elements.
+ */
+template<class Type>
+class BoundedQueue {
+private:
+	std::deque<Type> mElements;
+	size_t mCapacity;
+	bool mClosed = false;
+	std::mutex mMutex;
+	std::condition_variable mNotFull;
+	std::condition_variable mNotEmpty;
+
+public:
+	explicit BoundedQueue(const size_t capacity) : mCapacity(std::max<size_t>(1, capacity)) {
+	}
+
+	BoundedQueue(const BoundedQueue &other) = delete;
+	BoundedQueue &operator=(const BoundedQueue &other) = delete;
+
+	/**
+	 * @brief Wait for free space and append the element.
+	 *
+	 * @return False if the queue was closed, the element is dropped.
+	 */
+	bool push(Type element) {
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mNotFull.wait(lock, [this] {
+				return mClosed || mElements.size() < mCapacity;
+			});
+			if (mClosed) {
+				return false;
+			}
+			mElements.push_back(std::move(element));
+		}
+		mNotEmpty.notify_one();
+		return true;
+	}
+
+	/**
+	 * @brief Append the element only if there is free space.
+	 */
+	bool tryPush(Type element) {
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			if (mClosed || mElements.size() >= mCapacity) {
+				return false;
+			}
+			mElements.push_back(std::move(element));
+		}
+		mNotEmpty.notify_one();
+		return true;
+	}
+
+	/**
+	 * @brief Wait for the next element.
+	 *
+	 * @return The element, or std::nullopt once the queue is closed and drained.
+	 */
+	[[nodiscard]] std::optional<Type> pop() {
+		std::optional<Type> element;
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mNotEmpty.wait(lock, [this] {
+				return mClosed || !mElements.empty();
+			});
+			if (mElements.empty()) {
+				return std::nullopt;
+			}
+			element = std::move(mElements.front());
+			mElements.pop_front();
+		}
+		mNotFull.notify_one();
+		return element;
+	}
+
+	void close() {
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mClosed = true;
+		}
+		mNotFull.notify_all();
+		mNotEmpty.notify_all();
+	}
+
+	[[nodiscard]] size_t size() {
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mElements.size();
+	}
+
+	[[nodiscard]] size_t capacity() const noexcept {
+		return mCapacity;
+	}
+};
+
+/**
+ * @brief Lock-free ring buffer for exactly one producer and one consumer
+ * thread. Neither side ever blocks, a full queue rejects the element.
+ */
+template<class Type>
+class SpscQueue {
+private:
+	/** Keeps producer and consumer indices on separate cache lines */
+	static constexpr size_t cacheLine = 64;
+
+	std::unique_ptr<Type[]> mSlots;
+	size_t mMask;
+	alignas(cacheLine) std::atomic<size_t> mHead{0};
+	alignas(cacheLine) std::atomic<size_t> mTail{0};
+
+public:
+	/**
+	 * @brief The capacity is rounded up to a power of two.
+	 */
+	explicit SpscQueue(const size_t capacity) {
+		size_t size = 1;
+		while (size < std::max<size_t>(1, capacity)) {
+			size <<= 1;
+		}
+		mSlots = std::make_unique<Type[]>(size);
+		mMask  = size - 1;
+	}
+
+	SpscQueue(const SpscQueue &other) = delete;
+	SpscQueue &operator=(const SpscQueue &other) = delete;
+
+	/**
+	 * @brief Producer side, append the element unless the queue is full.
+	 */
+	bool tryPush(Type &&element) {
+		const size_t tail = mTail.load(std::memory_order_relaxed);
+		if (tail - mHead.load(std::memory_order_acquire) > mMask) {
+			return false;
+		}
+		mSlots[tail & mMask] = std::move(element);
+		mTail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Consumer side, take the oldest element if there is one.
+	 */
+	[[nodiscard]] std::optional<Type> tryPop() {
+		const size_t head = mHead.load(std::memory_order_relaxed);
+		if (head == mTail.load(std::memory_order_acquire)) {
+			return std::nullopt;
+		}
+		std::optional<Type> element(std::move(mSlots[head & mMask]));
+		mSlots[head & mMask] = Type();
+		mHead.store(head + 1, std::memory_order_release);
+		return element;
+	}
+
+	[[nodiscard]] size_t size() const noexcept {
+		// The head is read first, so it can never be ahead of the tail
+		const size_t head = mHead.load(std::memory_order_acquire);
+		return mTail.load(std::memory_order_acquire) - head;
+	}
+
+	[[nodiscard]] size_t capacity() const noexcept {
+		return mMask + 1;
+	}
+};
+
+} // namespace dv::toolkit
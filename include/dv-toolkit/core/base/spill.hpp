@@ -0,0 +1,162 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace dv::toolkit {
+
+/**
+ * @brief A fixed size extent of the scratch file mapped read-only. Spilled
+ * shards reference their extent and the extent is unmapped once the last
+ * of them is released, so the number of mappings grows with the size of the
+ * spilled data divided by the extent size rather than with the shard count.
+ */
+class SpillExtent {
+private:
+	void *mAddress;
+	size_t mLength;
+
+public:
+	SpillExtent(void *address, const size_t length) : mAddress(address), mLength(length) {
+	}
+
+	SpillExtent(const SpillExtent &other)            = delete;
+	SpillExtent &operator=(const SpillExtent &other) = delete;
+
+	~SpillExtent() {
+		munmap(mAddress, mLength);
+	}
+
+	[[nodiscard]] const void *data() const noexcept {
+		return mAddress;
+	}
+
+	[[nodiscard]] size_t size() const noexcept {
+		return mLength;
+	}
+};
+
+/**
+ * @brief Scratch file receiving shards evicted from memory by out-of-core
+ * storages. Spilled data is written once and mapped back read-only, so pages
+ * are reloaded on access and evicted again under memory pressure by the page
+ * cache of the operating system. The file is unlinked right after creation,
+ * its space is reclaimed once the file and all extents are released.
+ * A single scratch file may be shared by several storages.
+ */
+class SpillFile {
+private:
+	int mDescriptor = -1;
+	uint64_t mSize  = 0;
+	uint64_t mExtentSize;
+	/** Extent receiving new shards, and its offset in the file */
+	std::shared_ptr<const SpillExtent> mExtent;
+	uint64_t mExtentOffset = 0;
+	std::string mPath;
+	std::mutex mMutex;
+
+	static uint64_t pageSize() {
+		static const auto size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+		return size;
+	}
+
+	[[nodiscard]] std::shared_ptr<const SpillExtent> mapExtent(const uint64_t offset, const uint64_t length) {
+		// The file is grown sparsely, so every mapped page is backed by the file
+		if (::ftruncate(mDescriptor, static_cast<off_t>(offset + length)) != 0) {
+			throw std::runtime_error("Failed to grow scratch file " + mPath + ": " + std::strerror(errno));
+		}
+
+		void *address = mmap(nullptr, length, PROT_READ, MAP_SHARED, mDescriptor, static_cast<off_t>(offset));
+		if (address == MAP_FAILED) {
+			throw std::runtime_error("Failed to map scratch file " + mPath + ": " + std::strerror(errno));
+		}
+		return std::make_shared<const SpillExtent>(address, length);
+	}
+
+public:
+	/** Shards are placed on cache line boundaries inside an extent */
+	static constexpr uint64_t alignment = 64;
+
+	/**
+	 * @param path 		 Path of the scratch file
+	 * @param extentSize Bytes mapped at once, shards larger than an extent get an extent of their own
+	 */
+	explicit SpillFile(const std::filesystem::path &path, const uint64_t extentSize = uint64_t(1) << 30) :
+		mExtentSize((std::max<uint64_t>(extentSize, 1) + pageSize() - 1) / pageSize() * pageSize()),
+		mPath(path.string()) {
+		mDescriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+		if (mDescriptor < 0) {
+			throw std::runtime_error("Failed to create scratch file " + mPath + ": " + std::strerror(errno));
+		}
+		::unlink(path.c_str());
+	}
+
+	SpillFile(const SpillFile &other)            = delete;
+	SpillFile &operator=(const SpillFile &other) = delete;
+
+	~SpillFile() {
+		::close(mDescriptor);
+	}
+
+	/**
+	 * @brief Write `bytes` bytes to the end of the scratch file. The written
+	 * pages belong to the page cache, not to the process, and are written back
+	 * and evicted by the operating system.
+	 *
+	 * @return The written bytes inside their mapped extent, the pointer shares
+	 * ownership of the extent.
+	 */
+	[[nodiscard]] std::shared_ptr<const void> append(const void *data, const size_t bytes) {
+		std::shared_ptr<const SpillExtent> extent;
+		uint64_t offset       = 0;
+		uint64_t extentOffset = 0;
+		{
+			// Shards never straddle two extents, a new extent starts on a page boundary
+			std::lock_guard<std::mutex> lock(mMutex);
+			offset = (mSize + alignment - 1) / alignment * alignment;
+			if (mExtent == nullptr || offset + bytes > mExtentOffset + mExtent->size()) {
+				mExtentOffset = (mSize + pageSize() - 1) / pageSize() * pageSize();
+				mExtent       = mapExtent(mExtentOffset, std::max<uint64_t>(mExtentSize,
+					(bytes + pageSize() - 1) / pageSize() * pageSize()));
+				offset        = mExtentOffset;
+			}
+			mSize        = offset + bytes;
+			extent       = mExtent;
+			extentOffset = mExtentOffset;
+		}
+
+		const auto *position = static_cast<const char *>(data);
+		size_t written       = 0;
+		while (written < bytes) {
+			const ssize_t result
+				= ::pwrite(mDescriptor, position + written, bytes - written, static_cast<off_t>(offset + written));
+			if (result < 0 && errno != EINTR) {
+				throw std::runtime_error("Failed to write scratch file " + mPath + ": " + std::strerror(errno));
+			}
+			written += static_cast<size_t>(std::max<ssize_t>(result, 0));
+		}
+
+		const auto *address = static_cast<const char *>(extent->data()) + (offset - extentOffset);
+		return std::shared_ptr<const void>(std::move(extent), address);
+	}
+
+	/**
+	 * @brief Number of bytes written to the scratch file so far.
+	 */
+	[[nodiscard]] uint64_t size() {
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mSize;
+	}
+};
+
+} // namespace dv::toolkit
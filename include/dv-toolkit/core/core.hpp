@@ -4,9 +4,15 @@
 #include "./base/frame.hpp"
 #include "./base/imu.hpp"
 #include "./base/trigger.hpp"
+#include "./base/clock.hpp"
+#include "./base/concurrency.hpp"
 
+#include <algorithm>
+#include <exception>
+#include <optional>
 #include <unordered_map>
 #include <variant>
+#include <vector>
 
 namespace dv::toolkit {
 
@@ -56,54 +62,117 @@ public:
     }
 
     [[nodiscard]] inline StandardCameraType sliceByNumber(const std::string &name, const size_t start, const size_t length) const {
-        if (start + length > this->size(name)) {
-            throw std::range_error("Slice exceeds Data range");
-        }
-
-        if (length == 0) {
+        auto slicedData = sliceReference(name, start, length);
+        if (!slicedData.has_value()) {
             return StandardCameraType();
         }
-        
-        StandardCameraType slicedData;
-        slicedData[name] = std::visit(
-            [start, length](const auto &store) {
-                return UnifiedType(store.slice(start, length));
-            }, this->at(name));
-        const auto timeWindow = slicedData.timeWindow(name);
-        
+
+        const auto timeWindow = slicedData->timeWindow(name);
         for (const auto &[key, value] : (*this)) {
-            if (key == name) {
-                continue;
+            if (key != name) {
+                (*slicedData)[key] = sliceStream(value, timeWindow.startTime, timeWindow.endTime);
             }
-            slicedData[key] = std::visit(
-                [timeWindow](const auto &store) {
-                    return UnifiedType(store.sliceTime(
-                        timeWindow.startTime,
-                        timeWindow.endTime));
-                }, value);
         }
 
-        return slicedData;
+        return std::move(*slicedData);
     }
 
     [[nodiscard]] inline StandardCameraType sliceByTime(const std::string &name, const int64_t start) const {
         return sliceByTime(name, start, timeWindow(name).endTime + 1);
     }
 
-    [[nodiscard]] inline StandardCameraType sliceByTime(const std::string &name, const int64_t start, const int64_t end) const {
+    /**
+     * @brief Slice every stream by a window [start, end).
+     */
+    [[nodiscard]] inline StandardCameraType sliceByTime(const int64_t start, const int64_t end) const {
         StandardCameraType slicedData;
         for (const auto &[key, value] : (*this)) {
-            slicedData[key] = std::visit(
-                [start, end](const auto &store) {
-                    return UnifiedType(store.sliceTime(
-                        start,
-                        end));
-                }, value);
+            slicedData[key] = sliceStream(value, start, end);
         }
 
         return slicedData;
     }
 
+    [[nodiscard]] inline StandardCameraType sliceByTime(const std::string &, const int64_t start, const int64_t end) const {
+        return sliceByTime(start, end);
+    }
+
+    /**
+     * @brief Slice all streams concurrently on the given pool, one task per stream.
+     * The calling thread slices one of the streams itself. Called from a worker of 
+     * `pool`, all streams are sliced on the calling thread, since waiting for tasks 
+     * of its own pool could deadlock it.
+     */
+    [[nodiscard]] inline StandardCameraType sliceByTime(const int64_t start, const int64_t end, ThreadPool &pool) const {
+        StandardCameraType slicedData;
+        forEachStream(slicedData, pool, "", [start, end](const UnifiedType &value) {
+            return sliceStream(value, start, end);
+        });
+
+        return slicedData;
+    }
+
+    /**
+     * @brief Slice by number with the other streams sliced concurrently on the given
+     * pool, with the same fallback as the pooled sliceByTime().
+     */
+    [[nodiscard]] inline StandardCameraType sliceByNumber(
+        const std::string &name, const size_t start, const size_t length, ThreadPool &pool) const {
+        auto slicedData = sliceReference(name, start, length);
+        if (!slicedData.has_value()) {
+            return StandardCameraType();
+        }
+
+        const auto timeWindow = slicedData->timeWindow(name);
+        forEachStream(*slicedData, pool, name, [timeWindow](const UnifiedType &value) {
+            return sliceStream(value, timeWindow.startTime, timeWindow.endTime);
+        });
+
+        return std::move(*slicedData);
+    }
+
+    /**
+     * @brief Slice several time windows at once, window ranges are [startTime, endTime).
+     * Each stream is visited once for all windows, and when the windows are sorted by 
+     * start time each stream is scanned forward instead of searched per window.
+     */
+    [[nodiscard]] inline std::vector<StandardCameraType> sliceByTimeBatch(const std::vector<dv::TimeWindow> &windows) const {
+        std::vector<StandardCameraType> slicedData = emptyBatch(windows.size());
+        for (const auto &[key, value] : (*this)) {
+            sliceStreamBatch(key, value, windows, slicedData);
+        }
+
+        return slicedData;
+    }
+
+    /**
+     * @brief Batched slicing with one task per stream on the given pool, or on the
+     * calling thread when it is a worker of `pool`.
+     */
+    [[nodiscard]] inline std::vector<StandardCameraType> sliceByTimeBatch(
+        const std::vector<dv::TimeWindow> &windows, ThreadPool &pool) const {
+        if (pool.ownsCurrentThread()) {
+            return sliceByTimeBatch(windows);
+        }
+
+        std::vector<StandardCameraType> slicedData = emptyBatch(windows.size());
+
+        std::vector<std::future<void>> tasks;
+        std::exception_ptr failure;
+        try {
+            for (const auto &[key, value] : (*this)) {
+                tasks.push_back(pool.submit([this, &key, &value, &windows, &slicedData] {
+                    sliceStreamBatch(key, value, windows, slicedData);
+                }));
+            }
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        waitAll(tasks, failure);
+
+        return slicedData;
+    }
+
 	[[nodiscard]] inline size_t size(const std::string &name) const noexcept {
         return std::visit(
             [](const auto &store) {
@@ -117,6 +186,129 @@ public:
                 return store.timeWindow();
             }, this->at(name));
 	}
+
+private:
+    /**
+     * @brief Slice holding elements [start, start + length) of the reference stream
+     * only, std::nullopt if `length` is zero.
+     */
+    [[nodiscard]] std::optional<StandardCameraType> sliceReference(
+        const std::string &name, const size_t start, const size_t length) const {
+        if (start + length > this->size(name)) {
+            throw std::range_error("Slice exceeds Data range");
+        }
+
+        if (length == 0) {
+            return std::nullopt;
+        }
+
+        StandardCameraType slicedData;
+        slicedData[name] = std::visit(
+            [start, length](const auto &store) {
+                return UnifiedType(store.slice(start, length));
+            }, this->at(name));
+        return slicedData;
+    }
+
+    [[nodiscard]] static UnifiedType sliceStream(const UnifiedType &value, const int64_t start, const int64_t end) {
+        return std::visit(
+            [start, end](const auto &store) {
+                return UnifiedType(store.sliceTime(start, end));
+            }, value);
+    }
+
+    /**
+     * @brief Slices with every key inserted up front, so concurrent tasks only
+     * assign to the entries of their own stream.
+     */
+    [[nodiscard]] std::vector<StandardCameraType> emptyBatch(const size_t count) const {
+        std::vector<StandardCameraType> slicedData(count);
+        for (auto &slice : slicedData) {
+            for (const auto &[key, value] : (*this)) {
+                slice[key];
+            }
+        }
+        return slicedData;
+    }
+
+    /**
+     * @brief Wait for every task before rethrowing the first failure, tasks
+     * reference data owned by the caller.
+     */
+    static void waitAll(std::vector<std::future<void>> &tasks, std::exception_ptr failure) {
+        for (auto &task : tasks) {
+            try {
+                task.get();
+            } catch (...) {
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+
+    template<class SliceFunction>
+    void forEachStream(StandardCameraType &slicedData, ThreadPool &pool, const std::string &skip, 
+        const SliceFunction &function) const {
+        std::vector<std::pair<const UnifiedType *, UnifiedType *>> streams;
+        for (const auto &[key, value] : (*this)) {
+            if (key != skip) {
+                streams.emplace_back(&value, &slicedData[key]);
+            }
+        }
+
+        // Tasks of the pool must not wait for the pool, they slice every stream themselves
+        if (pool.ownsCurrentThread()) {
+            for (const auto &stream : streams) {
+                *stream.second = function(*stream.first);
+            }
+            return;
+        }
+
+        std::vector<std::future<void>> tasks;
+        std::exception_ptr failure;
+        try {
+            for (size_t i = 1; i < streams.size(); i++) {
+                tasks.push_back(pool.submit([&function, stream = streams[i]] {
+                    *stream.second = function(*stream.first);
+                }));
+            }
+            if (!streams.empty()) {
+                *streams.front().second = function(*streams.front().first);
+            }
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        waitAll(tasks, failure);
+    }
+
+    void sliceStreamBatch(const std::string &key, const UnifiedType &value, const std::vector<dv::TimeWindow> &windows,
+        std::vector<StandardCameraType> &slicedData) const {
+        const bool sorted = std::is_sorted(windows.begin(), windows.end(), 
+            [](const dv::TimeWindow &a, const dv::TimeWindow &b) {
+                return a.startTime < b.startTime;
+            });
+
+        std::visit(
+            [&key, &windows, &slicedData, sorted](const auto &store) {
+                auto cursor = store.cursorBegin();
+                for (size_t i = 0; i < windows.size(); i++) {
+                    const auto &window = windows[i];
+                    auto &slice        = slicedData[i].at(key);
+                    if (!sorted) {
+                        slice = UnifiedType(store.sliceTime(window.startTime, window.endTime));
+                        continue;
+                    }
+
+                    cursor        = store.advanceCursorToTime(cursor, window.startTime);
+                    const auto to = store.advanceCursorToTime(cursor, window.endTime);
+                    slice         = UnifiedType(store.sliceCursor(cursor, to));
+                }
+            }, value);
+    }
 };
 
 class MonoCameraData : public StandardCameraData<MonoCameraData> {
@@ -128,19 +320,19 @@ public:
         (*this)["triggers"] = TriggerStorage();
     };
 
-    [[nodiscard]] EventStorage events() const {
+    [[nodiscard]] const EventStorage &events() const {
         return std::get<EVTS>(this->at("events"));
     }
 
-    [[nodiscard]] FrameStorage frames() const {
+    [[nodiscard]] const FrameStorage &frames() const {
         return std::get<FRME>(this->at("frames"));
     }
 
-    [[nodiscard]] IMUStorage imus() const {
+    [[nodiscard]] const IMUStorage &imus() const {
         return std::get<IMUS>(this->at("imus"));
     }
 
-    [[nodiscard]] TriggerStorage triggers() const {
+    [[nodiscard]] const TriggerStorage &triggers() const {
         return std::get<TRIG>(this->at("triggers"));
     }
 };
@@ -150,9 +342,87 @@ public:
     CustomizedCameraData() = default;
 };
 
-class StereoCameraData : public std::unordered_map<std::string, MonoCameraData> {
+/**
+ * @brief Data of several cameras, each keeping timestamps of its own clock. A
+ * clock model per camera maps its local time to the common time base used for
+ * joint slicing, cameras without a model are assumed to be on the common base.
+ */
+class MultiCameraData : public std::unordered_map<std::string, MonoCameraData> {
+private:
+    std::unordered_map<std::string, ClockModel> mClocks;
+
+public:
+    MultiCameraData() = default;
+
+    void add(const MultiCameraData &other) {
+        for (const auto &[key, value] : other) {
+            (*this)[key].add(value);
+        }
+        for (const auto &[key, value] : other.mClocks) {
+            mClocks[key] = value;
+        }
+    }
+
+    [[nodiscard]] ClockModel clock(const std::string &name) const {
+        const auto clock = mClocks.find(name);
+        return (clock == mClocks.end()) ? ClockModel() : clock->second;
+    }
+
+    void setClock(const std::string &name, const ClockModel &clock) {
+        mClocks[name] = clock;
+    }
+
+    /**
+     * @brief Estimate the clock of every camera from triggers shared with the
+     * reference camera, whose clock becomes the common time base.
+     */
+    void synchronize(const std::string &reference, const std::string &triggers = "triggers") {
+        const auto &referenceTriggers = std::get<TRIG>(this->at(reference).at(triggers));
+        for (const auto &[key, value] : (*this)) {
+            mClocks[key] = (key == reference) 
+                ? ClockModel() 
+                : ClockModel::estimate(referenceTriggers, std::get<TRIG>(value.at(triggers)));
+        }
+    }
+
+    /**
+     * @brief Slice all cameras by a window [start, end) of common time. Sliced
+     * elements keep their local timestamps.
+     */
+    [[nodiscard]] MultiCameraData sliceByTime(const int64_t start, const int64_t end) const {
+        MultiCameraData slicedData;
+        slicedData.mClocks = mClocks;
+        for (const auto &[key, value] : (*this)) {
+            const auto clock = this->clock(key);
+            slicedData[key]  = value.sliceByTime(clock.toLocal(start), clock.toLocal(end));
+        }
+
+        return slicedData;
+    }
+
+    /**
+     * @brief Time window of a stream over all cameras, in common time.
+     */
+    [[nodiscard]] dv::TimeWindow timeWindow(const std::string &name) const {
+        int64_t lowest  = std::numeric_limits<int64_t>::max();
+        int64_t highest = std::numeric_limits<int64_t>::min();
+        for (const auto &[key, value] : (*this)) {
+            if (value.size(name) == 0) {
+                continue;
+            }
+            const auto clock  = this->clock(key);
+            const auto window = value.timeWindow(name);
+            lowest  = std::min(lowest, clock.toCommon(window.startTime));
+            highest = std::max(highest, clock.toCommon(window.endTime));
+        }
+
+        return (lowest > highest) ? dv::TimeWindow(0, 0) : dv::TimeWindow(lowest, highest);
+    }
+};
+
+class StereoCameraData : public MultiCameraData {
 public:
-    StereoCameraData() : std::unordered_map<std::string, MonoCameraData>() {
+    StereoCameraData() : MultiCameraData() {
         (*this)["left"]  = MonoCameraData();
         (*this)["right"] = MonoCameraData();
     }
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "./core.hpp"
+
+#include <vector>
+
+namespace dv::toolkit {
+
+/**
+ * @brief A single planned window: its time range and the index range
+ * [start, start + length) of the reference stream it covers.
+ */
+struct PlannedSlice {
+	dv::TimeWindow timeWindow;
+	size_t start{0};
+	size_t length{0};
+};
+
+/**
+ * @brief Windows of a whole recording computed up front, without slicing any
+ * data. Windows produce the same data as `DataSlicer` would emit for the same
+ * configuration and can be materialized lazily, in any order or concurrently.
+ */
+struct SlicePlan {
+	enum class SliceType {
+		NUMBER,
+		TIME
+	};
+
+	SliceType type = SliceType::TIME;
+	std::string reference;
+	std::vector<PlannedSlice> windows;
+
+	[[nodiscard]] size_t size() const noexcept {
+		return windows.size();
+	}
+
+	[[nodiscard]] bool empty() const noexcept {
+		return windows.empty();
+	}
+
+	[[nodiscard]] const PlannedSlice &operator[](const size_t index) const {
+		return windows[index];
+	}
+
+	/**
+	 * @brief Slice the data of a single window, the data is shared with `data`.
+	 */
+	template<class DataType>
+	[[nodiscard]] DataType materialize(const DataType &data, const size_t index) const {
+		if (index >= windows.size()) {
+			throw std::out_of_range("Window index exceeds the slice plan");
+		}
+
+		const auto &window = windows[index];
+		if (type == SliceType::NUMBER) {
+			return data.sliceByNumber(reference, window.start, window.length);
+		}
+		return data.sliceByTime(reference, window.timeWindow.startTime, window.timeWindow.endTime);
+	}
+};
+
+namespace internal {
+
+/**
+ * @brief Forward-only position within the partials of a storage. Timestamps
+ * are read in place and partials are skipped by their time range, so planning
+ * never copies the reference stream.
+ */
+template<class Storage>
+class PartialCursor {
+private:
+	using Type = typename Storage::value_type;
+
+	const std::vector<typename Storage::PartialDataType> &mPartials;
+	size_t mPartial = 0;
+	/** Global index of the first element of the current partial */
+	size_t mOffset = 0;
+	/** Global index of the cursor, within the current partial */
+	size_t mIndex = 0;
+
+	void nextPartial() {
+		mOffset += mPartials[mPartial].getLength();
+		mIndex = mOffset;
+		mPartial++;
+	}
+
+public:
+	explicit PartialCursor(const Storage &store) : mPartials(store.partials()) {
+	}
+
+	/**
+	 * @brief Timestamp of the element at `index`, the index must be within the
+	 * storage and must not decrease between calls.
+	 */
+	[[nodiscard]] int64_t timestampAt(const size_t index) {
+		while (index - mOffset >= mPartials[mPartial].getLength()) {
+			nextPartial();
+		}
+		mIndex = index;
+
+		const auto &element = *(mPartials[mPartial].begin() + (index - mOffset));
+		if constexpr (dv::concepts::TimestampedByAccessor<Type>) {
+			return element.timestamp();
+		} else {
+			return element.timestamp;
+		}
+	}
+
+	/**
+	 * @brief Index of the first element at or after `time`, the size of the
+	 * storage when there is none. Times must not decrease between calls.
+	 */
+	[[nodiscard]] size_t indexAtTime(const int64_t time) {
+		while (mPartial < mPartials.size()
+			   && (mPartials[mPartial].getLength() == 0 || mPartials[mPartial].getHighestTime() < time)) {
+			nextPartial();
+		}
+		if (mPartial == mPartials.size()) {
+			return mOffset;
+		}
+
+		const auto &partial = mPartials[mPartial];
+		const auto element  = std::lower_bound(
+			partial.begin() + (mIndex - mOffset), partial.end(), time, TimeComparator<Type>());
+		mIndex = mOffset + static_cast<size_t>(element - partial.begin());
+		return mIndex;
+	}
+};
+
+} // namespace internal
+
+/**
+ * @brief Plan windows of `n` reference elements starting every `stride`
+ * elements. Trailing elements that do not fill a window are not planned.
+ */
+template<class DataType>
+[[nodiscard]] inline SlicePlan planSlices(const DataType &data, const std::string &name, const size_t n, const size_t stride) {
+	if (n == 0 || stride == 0) {
+		throw std::invalid_argument("Number interval and stride must be greater than zero");
+	}
+
+	SlicePlan plan;
+	plan.type      = SlicePlan::SliceType::NUMBER;
+	plan.reference = name;
+
+	std::visit(
+		[&plan, n, stride](const auto &store) {
+			if (store.size() < n) {
+				return;
+			}
+
+			// Both ends of the windows only move forward, each is read in place
+			// by its own cursor
+			internal::PartialCursor first(store);
+			internal::PartialCursor last(store);
+			plan.windows.reserve((store.size() - n) / stride + 1);
+			for (size_t start = 0; start + n <= store.size(); start += stride) {
+				const int64_t startTime = first.timestampAt(start);
+				plan.windows.push_back(PlannedSlice{dv::TimeWindow(startTime, last.timestampAt(start + n - 1)), start, n});
+			}
+		}, data.at(name));
+	return plan;
+}
+
+template<class DataType>
+[[nodiscard]] inline SlicePlan planSlices(const DataType &data, const std::string &name, const size_t n) {
+	return planSlices(data, name, n, n);
+}
+
+/**
+ * @brief Plan windows of `interval` duration starting every `stride`, aligned
+ * to the first reference timestamp. A window is planned once the reference
+ * stream covers its whole duration, window time ranges are [start, end).
+ */
+template<class DataType>
+[[nodiscard]] inline SlicePlan planSlices(
+	const DataType &data, const std::string &name, const dv::Duration interval, const dv::Duration stride) {
+	if (interval.count() <= 0 || stride.count() <= 0) {
+		throw std::invalid_argument("Time interval and stride must be greater than zero");
+	}
+
+	SlicePlan plan;
+	plan.type      = SlicePlan::SliceType::TIME;
+	plan.reference = name;
+
+	std::visit(
+		[&plan, &interval, &stride](const auto &store) {
+			if (store.isEmpty()) {
+				return;
+			}
+
+			const int64_t lowestTime  = store.getLowestTime();
+			const int64_t highestTime = store.getHighestTime();
+			const int64_t length      = interval.count();
+			const int64_t step        = stride.count();
+			if (highestTime - lowestTime >= length) {
+				plan.windows.reserve(static_cast<size_t>((highestTime - lowestTime - length) / step + 1));
+			}
+
+			// Window bounds only move forward, so both ends are found with a single
+			// monotonic walk over the partials instead of a search per window
+			internal::PartialCursor lower(store);
+			internal::PartialCursor upper(store);
+			for (int64_t startTime = lowestTime; highestTime - startTime >= length; startTime += step) {
+				const int64_t endTime = startTime + length;
+				const size_t start    = lower.indexAtTime(startTime);
+				plan.windows.push_back(
+					PlannedSlice{dv::TimeWindow(startTime, endTime), start, upper.indexAtTime(endTime) - start});
+			}
+		}, data.at(name));
+	return plan;
+}
+
+template<class DataType>
+[[nodiscard]] inline SlicePlan planSlices(const DataType &data, const std::string &name, const dv::Duration interval) {
+	return planSlices(data, name, interval, interval);
+}
+
+} // namespace dv::toolkit
@@ -0,0 +1,221 @@
+#pragma once
+
+#include "./core.hpp"
+
+#include <algorithm>
+#include <string_view>
+#include <tuple>
+
+namespace dv::toolkit {
+
+/**
+ * @brief String literal usable as a template argument, names the streams of a
+ * typed camera data schema.
+ */
+template<size_t N>
+struct FixedString {
+	char value[N]{};
+
+	constexpr FixedString(const char (&str)[N]) {
+		std::copy_n(str, N, value);
+	}
+
+	[[nodiscard]] constexpr std::string_view view() const noexcept {
+		return std::string_view(value, N - 1);
+	}
+
+	template<size_t M>
+	[[nodiscard]] constexpr bool operator==(const FixedString<M> &other) const noexcept {
+		return view() == other.view();
+	}
+};
+
+/**
+ * @brief A named stream of a typed camera data schema.
+ */
+template<FixedString Name, class StorageType>
+struct Stream {
+	static constexpr auto name = Name;
+	using type                 = StorageType;
+};
+
+/**
+ * @brief Camera data with a schema fixed at compile time. Streams are stored in
+ * a tuple and selected by name at compile time, so accessing and slicing them
+ * involves no hashing, no variant visitation and no storage copies. The slicing
+ * API mirrors `StandardCameraData`, `TypedCameraType` is the deriving class.
+ *
+ * @code
+ * class PoseCameraData : public TypedCameraData<PoseCameraData,
+ *     Stream<"events", EventStorage>, Stream<"imus", IMUStorage>> {};
+ * @endcode
+ */
+template<class TypedCameraType, class... Streams>
+class TypedCameraData {
+public:
+	using TupleType = std::tuple<typename Streams::type...>;
+
+private:
+	TupleType mStores;
+
+	template<FixedString Name>
+	[[nodiscard]] static consteval size_t indexOf() {
+		constexpr bool matches[] = {(Streams::name == Name)...};
+		for (size_t i = 0; i < sizeof...(Streams); i++) {
+			if (matches[i]) {
+				return i;
+			}
+		}
+		return sizeof...(Streams);
+	}
+
+public:
+	template<FixedString Name>
+	static constexpr bool contains = indexOf<Name>() < sizeof...(Streams);
+
+	/**
+	 * @brief Build from string-keyed camera data, streams missing in `data` stay empty.
+	 */
+	template<class UnifiedData>
+	[[nodiscard]] static TypedCameraType from(const UnifiedData &data) {
+		TypedCameraType typed;
+		(static_cast<TypedCameraData &>(typed).template fromStream<Streams>(data), ...);
+		return typed;
+	}
+
+	/**
+	 * @brief Convert to string-keyed camera data, storages are shared, not copied.
+	 */
+	template<class UnifiedData>
+	[[nodiscard]] UnifiedData to() const {
+		UnifiedData data;
+		((data[std::string(Streams::name.view())] = get<Streams::name>()), ...);
+		return data;
+	}
+
+	template<FixedString Name>
+	[[nodiscard]] auto &get() noexcept {
+		static_assert(contains<Name>, "Stream is not part of the schema");
+		return std::get<indexOf<Name>()>(mStores);
+	}
+
+	template<FixedString Name>
+	[[nodiscard]] const auto &get() const noexcept {
+		static_assert(contains<Name>, "Stream is not part of the schema");
+		return std::get<indexOf<Name>()>(mStores);
+	}
+
+	[[nodiscard]] const TupleType &stores() const noexcept {
+		return mStores;
+	}
+
+	void add(const TypedCameraType &other) {
+		std::apply(
+			[&other](auto &...stores) {
+				std::apply(
+					[&stores...](const auto &...otherStores) {
+						(stores.add(otherStores), ...);
+					}, other.stores());
+			}, mStores);
+	}
+
+	template<FixedString Name>
+	[[nodiscard]] TypedCameraType sliceByNumber(const size_t start) const {
+		const size_t count = size<Name>();
+		if (count == 0 || start >= count) {
+			return TypedCameraType();
+		}
+
+		return sliceByNumber<Name>(start, count - start);
+	}
+
+	template<FixedString Name>
+	[[nodiscard]] TypedCameraType sliceByNumber(const size_t start, const size_t length) const {
+		if (start + length > size<Name>()) {
+			throw std::range_error("Slice exceeds Data range");
+		}
+
+		if (length == 0) {
+			return TypedCameraType();
+		}
+
+		TypedCameraType slicedData;
+		auto &sliced = static_cast<TypedCameraData &>(slicedData);
+		sliced.template get<Name>() = get<Name>().slice(start, length);
+		const auto timeWindow = sliced.template timeWindow<Name>();
+		(sliced.template sliceOther<Streams, Name>(*this, timeWindow.startTime, timeWindow.endTime), ...);
+		return slicedData;
+	}
+
+	template<FixedString Name>
+	[[nodiscard]] TypedCameraType sliceByTime(const int64_t start) const {
+		return sliceByTime<Name>(start, timeWindow<Name>().endTime + 1);
+	}
+
+	template<FixedString Name>
+	[[nodiscard]] TypedCameraType sliceByTime(const int64_t start, const int64_t end) const {
+		TypedCameraType slicedData;
+		static_cast<TypedCameraData &>(slicedData).mStores = std::apply(
+			[start, end](const auto &...stores) {
+				return TupleType(stores.sliceTime(start, end)...);
+			}, mStores);
+		return slicedData;
+	}
+
+	template<FixedString Name>
+	[[nodiscard]] size_t size() const noexcept {
+		return get<Name>().size();
+	}
+
+	template<FixedString Name>
+	[[nodiscard]] dv::TimeWindow timeWindow() const noexcept {
+		return get<Name>().timeWindow();
+	}
+
+private:
+	template<class StreamType, class UnifiedData>
+	void fromStream(const UnifiedData &data) {
+		const auto iterator = data.find(std::string(StreamType::name.view()));
+		if (iterator != data.end()) {
+			get<StreamType::name>() = std::get<typename StreamType::type>(iterator->second);
+		}
+	}
+
+	template<class StreamType, FixedString Name>
+	void sliceOther(const TypedCameraData &source, const int64_t startTime, const int64_t endTime) {
+		if constexpr (!(StreamType::name == Name)) {
+			get<StreamType::name>() = source.template get<StreamType::name>().sliceTime(startTime, endTime);
+		}
+	}
+};
+
+/**
+ * @brief Typed counterpart of `MonoCameraData`.
+ */
+class TypedMonoCameraData : public TypedCameraData<TypedMonoCameraData, Stream<"events", EventStorage>,
+								Stream<"frames", FrameStorage>, Stream<"imus", IMUStorage>, Stream<"triggers", TriggerStorage>> {
+public:
+	TypedMonoCameraData() = default;
+
+	[[nodiscard]] MonoCameraData toMonoCameraData() const {
+		return to<MonoCameraData>();
+	}
+
+	[[nodiscard]] const EventStorage &events() const noexcept {
+		return get<"events">();
+	}
+
+	[[nodiscard]] const FrameStorage &frames() const noexcept {
+		return get<"frames">();
+	}
+
+	[[nodiscard]] const IMUStorage &imus() const noexcept {
+		return get<"imus">();
+	}
+
+	[[nodiscard]] const TriggerStorage &triggers() const noexcept {
+		return get<"triggers">();
+	}
+};
+
+} // namespace dv::toolkit
@@ -1,29 +1,931 @@
 #pragma once
 
 #include "./core.hpp"
+#include "./base/concurrency.hpp"
+
+#include <chrono>
+#include <exception>
+#include <optional>
+#include <tuple>
+#include <utility>
 
 namespace dv::toolkit {
 
+/**
+ * @brief Behaviour of an asynchronously dispatched job when its queue is full.
+ */
+enum class BackpressurePolicy {
+	/** Block the accepting thread until the job has room again */
+	BLOCK,
+	/** Discard the oldest pending window */
+	DROP_OLDEST,
+	/** Merge the new window into the newest pending window */
+	COALESCE
+};
+
+/**
+ * @brief Dispatch counters of a single slicing job.
+ */
+struct JobStatistics {
+	/** Number of windows waiting for the callback */
+	size_t queueDepth{0};
+	/** Highest number of windows that were waiting at the same time */
+	size_t maxQueueDepth{0};
+	/** Number of callback invocations */
+	size_t dispatched{0};
+	/** Number of windows discarded by DROP_OLDEST */
+	size_t dropped{0};
+	/** Number of windows merged by COALESCE */
+	size_t coalesced{0};
+	/** Time from emitting a window until its callback returned */
+	dv::Duration lastLatency{0};
+	dv::Duration maxLatency{0};
+	dv::Duration meanLatency{0};
+};
+
+namespace internal {
+
+/**
+ * @brief Streams of an ingest buffer resolved to their storage types. A stream
+ * gets a fixed index when it is first registered or seen, and its storage is
+ * kept by type, so jobs walk the streams without name lookups or std::visit.
+ * Streams are resolved again whenever the buffer gains a stream or is another
+ * object than before, e.g. after the owning slicer was copied.
+ */
+template<class DataType>
+class StreamLayout {
+public:
+	template<class Store>
+	struct Stream {
+		std::string name;
+		size_t index;
+		Store *store;
+	};
+
+private:
+	template<class Variant>
+	struct Streams;
+
+	template<class... Stores>
+	struct Streams<std::variant<Stores...>> {
+		using Tuple   = std::tuple<std::vector<Stream<Stores>>...>;
+		using Pointer = std::variant<Stores *...>;
+	};
+
+	using UnifiedType = typename DataType::UnifiedType;
+	using Pointer     = typename Streams<UnifiedType>::Pointer;
+
+	std::vector<std::string> mNames;
+	/** Storage of every index, std::nullopt while the stream is not buffered */
+	std::vector<std::optional<Pointer>> mStores;
+	typename Streams<UnifiedType>::Tuple mStreams;
+	const DataType *mBuffer = nullptr;
+	size_t mResolved = 0;
+
+public:
+	/**
+	 * @brief Index of the named stream, registered if it is not known yet.
+	 */
+	size_t index(const std::string &name) {
+		for (size_t i = 0; i < mNames.size(); i++) {
+			if (mNames[i] == name) {
+				return i;
+			}
+		}
+		mNames.push_back(name);
+		mStores.emplace_back(std::nullopt);
+		return mNames.size() - 1;
+	}
+
+	/**
+	 * @brief Pick up the storages of `buffer`, a no-op while it neither gained
+	 * a stream nor changed. Streams are never removed from an ingest buffer.
+	 */
+	void resolve(DataType &buffer) {
+		// Containers hide the map size behind the size of a stream
+		const auto count = static_cast<size_t>(std::distance(buffer.begin(), buffer.end()));
+		if (mBuffer == &buffer && mResolved == count) {
+			return;
+		}
+		if (mBuffer != &buffer) {
+			std::fill(mStores.begin(), mStores.end(), std::nullopt);
+			std::apply(
+				[](auto &...streams) {
+					(streams.clear(), ...);
+				}, mStreams);
+		}
+
+		for (auto &[key, value] : buffer) {
+			const size_t streamIndex = index(key);
+			if (mStores[streamIndex].has_value()) {
+				continue;
+			}
+			std::visit(
+				[this, &key, streamIndex](auto &store) {
+					using Store = std::decay_t<decltype(store)>;
+					mStores[streamIndex] = Pointer(&store);
+					std::get<std::vector<Stream<Store>>>(mStreams).push_back(Stream<Store>{key, streamIndex, &store});
+				}, value);
+		}
+		mBuffer   = &buffer;
+		mResolved = count;
+	}
+
+	[[nodiscard]] size_t size() const noexcept {
+		return mNames.size();
+	}
+
+	[[nodiscard]] bool contains(const size_t streamIndex) const noexcept {
+		return streamIndex < mStores.size() && mStores[streamIndex].has_value();
+	}
+
+	/**
+	 * @brief Call `function` on every buffered stream, grouped by storage type.
+	 */
+	template<class Function>
+	void forEach(Function &&function) const {
+		std::apply(
+			[&function](const auto &...streams) {
+				(std::for_each(streams.begin(), streams.end(), function), ...);
+			}, mStreams);
+	}
+
+	/**
+	 * @brief Call `function` on the storage of a buffered stream, the only dispatch
+	 * on the storage type. Jobs do it once per call for their reference stream.
+	 */
+	template<class Function>
+	decltype(auto) visit(const size_t streamIndex, Function &&function) const {
+		return std::visit(
+			[&function](auto *store) -> decltype(auto) {
+				return function(*store);
+			}, *mStores[streamIndex]);
+	}
+};
+
+/**
+ * @brief Buffer of a job whose reference stream was resolved to its storage type.
+ */
+template<class DataType, class Store>
+struct TypedReference {
+	const StreamLayout<DataType> &streams;
+	const Store &store;
+};
+
+/** Container type of a buffer passed to the job functions */
+template<class Buffer>
+struct BufferData {
+	using type = Buffer;
+};
+
+template<class DataType, class Store>
+struct BufferData<TypedReference<DataType, Store>> {
+	using type = DataType;
+};
+
+/**
+ * @brief Cursor and window state of a slicing job, shared by `DataSlicer` and
+ * `StaticDataSlicer`. Jobs only differ in how they store and dispatch their
+ * callbacks, the run functions hand every window to the given callable.
+ * Cursors are kept in a flat vector, containers hold a handful of streams at most.
+ * Jobs bound to a `StreamLayout` keep their cursors by stream index instead, and
+ * slice every stream through its storage type.
+ */
+class SliceJobBase {
+protected:
+	/** Start of the next window in every stream of the shared buffer */
+	std::vector<std::pair<std::string, StorageCursor>> mCursors;
+	/** Same for jobs bound to a stream layout, by stream index */
+	std::vector<StorageCursor> mStreamCursors;
+	std::string mReference;
+	size_t 	mReferenceIndex = 0;
+	bool 	mStarted 		= false;
+	int64_t mTimeInterval 	= -1;
+	int64_t mTimeStride 	= -1;
+	int64_t mLastCallTime 	= 0;
+	size_t 	mNumberInterval = 0;
+	size_t 	mNumberStride 	= 0;
+	/** Reference elements still to be skipped when the stride exceeds the window */
+	size_t 	mPendingSkip 	= 0;
+
+	SliceJobBase() = default;
+
+	SliceJobBase(std::string reference, const int64_t timeInterval, const int64_t timeStride,
+		const size_t numberInterval, const size_t numberStride) :
+		mReference(std::move(reference)),
+		mTimeInterval(timeInterval),
+		mTimeStride(timeStride),
+		mNumberInterval(numberInterval),
+		mNumberStride(numberStride) {
+	}
+
+	[[nodiscard]] StorageCursor &cursor(const std::string &name) {
+		for (auto &[key, value] : mCursors) {
+			if (key == name) {
+				return value;
+			}
+		}
+		return mCursors.emplace_back(name, StorageCursor()).second;
+	}
+
+	[[nodiscard]] StorageCursor cursor(const std::string &name) const {
+		for (const auto &[key, value] : mCursors) {
+			if (key == name) {
+				return value;
+			}
+		}
+		return StorageCursor();
+	}
+
+	/** Make room for the cursors of streams the layout gained since the last call */
+	template<class DataType>
+	void growCursors(const StreamLayout<DataType> &streams) {
+		if (mStreamCursors.size() < streams.size()) {
+			mStreamCursors.resize(streams.size());
+		}
+	}
+
+	/** Move the cursor of a stream to the end of the buffered data */
+	template<class DataType>
+	void followTail(const DataType &buffer, const std::string &name) {
+		cursor(name) = std::visit(
+			[](const auto &store) {
+				return store.cursorEnd();
+			}, buffer.at(name));
+	}
+
+	/** Call `function` with the reference storage and its cursor */
+	template<class DataType, class Function>
+	decltype(auto) withReference(const DataType &buffer, Function &&function) {
+		return std::visit(
+			[this, &function](const auto &store) -> decltype(auto) {
+				return function(store, cursor(mReference));
+			}, buffer.at(mReference));
+	}
+
+	template<class DataType, class Store, class Function>
+	decltype(auto) withReference(const TypedReference<DataType, Store> &buffer, Function &&function) {
+		return function(buffer.store, mStreamCursors[mReferenceIndex]);
+	}
+
+	template<class DataType>
+	void sliceStreams(const DataType &buffer, DataType &slice, const int64_t startTime, const int64_t endTime,
+		const int64_t nextTime, const std::string &skip) {
+		using UnifiedType = typename DataType::UnifiedType;
+
+		for (const auto &[key, value] : buffer) {
+			if (key == skip) {
+				continue;
+			}
+			slice[key] = std::visit(
+				[this, &key, startTime, endTime, nextTime](const auto &store) {
+					auto &current   = cursor(key);
+					const auto from = store.advanceCursorToTime(current, startTime);
+					const auto to   = store.advanceCursorToTime(from, endTime);
+					current         = store.advanceCursorToTime(from, nextTime);
+					return UnifiedType(store.sliceCursor(from, to));
+				}, value);
+		}
+	}
+
+	template<class DataType, class Store>
+	void sliceStreams(const TypedReference<DataType, Store> &buffer, DataType &slice, const int64_t startTime,
+		const int64_t endTime, const int64_t nextTime, const std::string &skip) {
+		using UnifiedType = typename DataType::UnifiedType;
+
+		const bool skipReference = (skip == mReference);
+		buffer.streams.forEach([this, &slice, skipReference, startTime, endTime, nextTime](const auto &stream) {
+			if (skipReference && stream.index == mReferenceIndex) {
+				return;
+			}
+			auto &current   = mStreamCursors[stream.index];
+			const auto from = stream.store->advanceCursorToTime(current, startTime);
+			const auto to   = stream.store->advanceCursorToTime(from, endTime);
+			current         = stream.store->advanceCursorToTime(from, nextTime);
+			slice[stream.name] = UnifiedType(stream.store->sliceCursor(from, to));
+		});
+	}
+
+	template<class DataType>
+	[[nodiscard]] std::optional<int64_t> nextTime(const DataType &buffer, const std::string &name) const {
+		return std::visit(
+			[this, &name](const auto &store) -> std::optional<int64_t> {
+				const size_t index = store.cursorIndex(cursor(name));
+				if (index >= store.size()) {
+					return std::nullopt;
+				}
+				if constexpr (dv::concepts::TimestampedByAccessor<typename std::decay_t<decltype(store)>::value_type>) {
+					return store.at(index).timestamp();
+				} else {
+					return store.at(index).timestamp;
+				}
+			}, buffer.at(name));
+	}
+
+	/** Timestamp of the next unused reference element */
+	template<class Buffer>
+	[[nodiscard]] std::optional<int64_t> nextReferenceTime(const Buffer &buffer) {
+		return withReference(buffer, [](const auto &store, const StorageCursor &current) -> std::optional<int64_t> {
+			const size_t index = store.cursorIndex(current);
+			if (index >= store.size()) {
+				return std::nullopt;
+			}
+			if constexpr (dv::concepts::TimestampedByAccessor<typename std::decay_t<decltype(store)>::value_type>) {
+				return store.at(index).timestamp();
+			} else {
+				return store.at(index).timestamp;
+			}
+		});
+	}
+
+	/**
+	 * @brief Start the job at the next element of the given stream.
+	 *
+	 * @return False while that stream has no element yet.
+	 */
+	template<class DataType>
+	[[nodiscard]] bool start(const DataType &buffer, const std::string &name) {
+		const auto startTime = nextTime(buffer, name);
+		if (!startTime.has_value()) {
+			return false;
+		}
+		mStarted      = true;
+		mLastCallTime = *startTime;
+		return true;
+	}
+
+	/**
+	 * @brief Start a job bound to a layout at the next element of its reference stream.
+	 *
+	 * @return False while that stream has no element yet.
+	 */
+	template<class DataType>
+	[[nodiscard]] bool start(const StreamLayout<DataType> &streams) {
+		if (!streams.contains(mReferenceIndex)) {
+			return false;
+		}
+
+		growCursors(streams);
+		const auto startTime = streams.visit(mReferenceIndex, [this, &streams](const auto &store) {
+			return nextReferenceTime(TypedReference<DataType, std::decay_t<decltype(store)>>{streams, store});
+		});
+		if (!startTime.has_value()) {
+			return false;
+		}
+		mStarted      = true;
+		mLastCallTime = *startTime;
+		return true;
+	}
+
+	template<class Buffer>
+	[[nodiscard]] typename BufferData<Buffer>::type sliceByNumber(const Buffer &buffer) {
+		using DataType    = typename BufferData<Buffer>::type;
+		using UnifiedType = typename DataType::UnifiedType;
+
+		DataType slice;
+		dv::TimeWindow timeWindow(0, 0);
+		size_t skipped = 0;
+		withReference(buffer, [this, &slice, &timeWindow, &skipped](const auto &store, StorageCursor &current) {
+			const auto from = current;
+			const auto to   = store.advanceCursor(from, mNumberInterval);
+			current         = store.advanceCursor(from, mNumberStride);
+			skipped         = store.cursorIndex(current) - store.cursorIndex(from);
+
+			auto sliced       = store.sliceCursor(from, to);
+			timeWindow        = sliced.timeWindow();
+			slice[mReference] = UnifiedType(std::move(sliced));
+		});
+		mPendingSkip = mNumberStride - skipped;
+
+		// Other streams may only move up to the start of the next window, which
+		// is unknown yet if the stride reaches past the buffered data
+		const auto startTime = nextReferenceTime(buffer).value_or(timeWindow.startTime);
+		sliceStreams(buffer, slice, timeWindow.startTime, timeWindow.endTime,
+			(mPendingSkip == 0) ? startTime : timeWindow.startTime, mReference);
+		return slice;
+	}
+
+	template<class Buffer>
+	void skipPending(const Buffer &buffer) {
+		withReference(buffer, [this](const auto &store, StorageCursor &current) {
+			const auto from = current;
+			current         = store.advanceCursor(from, mPendingSkip);
+			mPendingSkip   -= store.cursorIndex(current) - store.cursorIndex(from);
+		});
+	}
+
+	template<class Buffer>
+	[[nodiscard]] size_t remainingNumber(const Buffer &buffer) {
+		return withReference(buffer, [](const auto &store, const StorageCursor &current) {
+			return store.size() - store.cursorIndex(current);
+		});
+	}
+
+	template<class Buffer>
+	[[nodiscard]] int64_t referenceEndTime(const Buffer &buffer) {
+		return withReference(buffer, [](const auto &store, const StorageCursor &) {
+			return store.timeWindow().endTime;
+		});
+	}
+
+	/** Emit every complete window of `mNumberInterval` reference elements */
+	template<class Buffer, class Emit>
+	void runNumber(const Buffer &buffer, Emit &&emit) {
+		while (true) {
+			if (mPendingSkip > 0) {
+				skipPending(buffer);
+			}
+			if (mPendingSkip > 0 || remainingNumber(buffer) < mNumberInterval) {
+				break;
+			}
+
+			auto slice    = sliceByNumber(buffer);
+			mLastCallTime = slice.timeWindow(mReference).endTime;
+			emit(slice.timeWindow(mReference), slice);
+		}
+	}
+
+	/** Emit every window of `mTimeInterval` the reference stream has passed */
+	template<class Buffer, class Emit>
+	void runTime(const Buffer &buffer, Emit &&emit) {
+		using DataType = typename BufferData<Buffer>::type;
+
+		while (referenceEndTime(buffer) - mLastCallTime >= mTimeInterval) {
+			DataType slice;
+			sliceStreams(buffer, slice, mLastCallTime, mLastCallTime + mTimeInterval, mLastCallTime + mTimeStride, "");
+			mLastCallTime = mLastCallTime + mTimeStride;
+			emit(slice.timeWindow(mReference), slice);
+		}
+	}
+
+	/** Layout counterparts, the reference storage type is dispatched once per call */
+	template<class DataType, class Emit>
+	void runNumber(const StreamLayout<DataType> &streams, Emit &&emit) {
+		growCursors(streams);
+		streams.visit(mReferenceIndex, [this, &streams, &emit](const auto &store) {
+			runNumber(TypedReference<DataType, std::decay_t<decltype(store)>>{streams, store}, emit);
+		});
+	}
+
+	template<class DataType, class Emit>
+	void runTime(const StreamLayout<DataType> &streams, Emit &&emit) {
+		growCursors(streams);
+		streams.visit(mReferenceIndex, [this, &streams, &emit](const auto &store) {
+			runTime(TypedReference<DataType, std::decay_t<decltype(store)>>{streams, store}, emit);
+		});
+	}
+
+public:
+	/**
+	 * @brief Register the reference stream with the layout of the slicer, its
+	 * index is resolved once here instead of by name on every call.
+	 */
+	template<class DataType>
+	void bind(StreamLayout<DataType> &streams) {
+		mReferenceIndex = streams.index(mReference);
+	}
+
+	/**
+	 * @brief Jobs that have not seen their reference stream yet only follow
+	 * the tail of the buffer, so they neither replay nor pin older data.
+	 */
+	template<class DataType>
+	void prepare(const DataType &buffer) {
+		if (mStarted) {
+			return;
+		}
+
+		for (const auto &[key, value] : buffer) {
+			followTail(buffer, key);
+		}
+	}
+
+	template<class DataType>
+	void prepare(const StreamLayout<DataType> &streams) {
+		if (mStarted) {
+			return;
+		}
+
+		growCursors(streams);
+		streams.forEach([this](const auto &stream) {
+			mStreamCursors[stream.index] = stream.store->cursorEnd();
+		});
+	}
+
+	[[nodiscard]] size_t consumedPartials(const std::string &name) const {
+		return cursor(name).partialIndex;
+	}
+
+	void rebase(const std::string &name, const size_t releasedPartials) {
+		cursor(name).partialIndex -= releasedPartials;
+	}
+
+	[[nodiscard]] size_t consumedPartials(const size_t streamIndex) const {
+		return (streamIndex < mStreamCursors.size()) ? mStreamCursors[streamIndex].partialIndex : 0;
+	}
+
+	void rebase(const size_t streamIndex, const size_t releasedPartials) {
+		if (streamIndex < mStreamCursors.size()) {
+			mStreamCursors[streamIndex].partialIndex -= releasedPartials;
+		}
+	}
+};
+
+/**
+ * @brief Drop the shards of every stream that all jobs have passed and rebase
+ * the cursors of the jobs onto the remaining ones.
+ *
+ * @param consumed 	Number of leading shards of a stream all jobs are done with
+ * @param rebase 	Shift the cursors of all jobs by the number of released shards
+ */
+template<class DataType, class Consumed, class Rebase>
+inline void releaseConsumed(DataType &buffer, Consumed &&consumed, Rebase &&rebase) {
+	for (auto &[key, value] : buffer) {
+		const size_t count = consumed(key);
+		const size_t released = std::visit(
+			[count](auto &store) {
+				const size_t available = std::min(count, store.cursorEnd().partialIndex);
+				store.releasePartials(available);
+				return available;
+			}, value);
+
+		if (released == 0) {
+			continue;
+		}
+		rebase(key, released);
+	}
+}
+
+} // namespace internal
+
 // add template requires
 template<class DataType>
 class DataSlicer {
 protected:
-    class SliceJob{
+	/**
+	 * @brief Hands windows of one job to its callback, either inline or on a
+	 * thread pool. At most one window of a job is processed at a time, so the
+	 * callback sees windows in emission order. The first error thrown by an
+	 * asynchronous callback is kept, the windows pending at that point are
+	 * dropped, and the error is rethrown to the accepting thread.
+	 */
+	class JobQueue : public std::enable_shared_from_this<JobQueue> {
+		using JobCallback = std::function<void(const dv::TimeWindow &, const DataType &)>;
+		using Clock       = std::chrono::steady_clock;
+
+		struct PendingWindow {
+			dv::TimeWindow window;
+			DataType data;
+			Clock::time_point emitted;
+			/** Set once the window holds copies instead of shards of the ingest buffer */
+			bool detached = false;
+		};
+
+	private:
+		JobCallback mCallback;
+		ThreadPool *mPool = nullptr;
+		size_t mCapacity = 1;
+		BackpressurePolicy mPolicy = BackpressurePolicy::BLOCK;
+		std::deque<PendingWindow> mPending;
+		bool mScheduled = false;
+		std::exception_ptr mError;
+		JobStatistics mStatistics;
+		mutable std::mutex mMutex;
+		std::condition_variable mCondition;
+
+		/** Copy of `store` in a packet of its own, so later merges never write into shared shards */
+		template<class StoreType>
+		[[nodiscard]] static StoreType detach(const StoreType &store) {
+			if (store.isEmpty()) {
+				return StoreType();
+			}
+			auto packet = std::make_shared<typename StoreType::packet_type>();
+			packet->elements.reserve(store.size());
+			for (const auto &element : store) {
+				packet->elements.push_back(element);
+			}
+			return StoreType(std::shared_ptr<const typename StoreType::packet_type>(std::move(packet)));
+		}
+
+		/**
+		 * @brief Extend the pending window by the elements of `data` past its end. The
+		 * first merge copies the pending window, its shards may be shared with the
+		 * ingest buffer or with a window a worker is reading. Elements sharing the
+		 * last timestamp of the pending window are kept once.
+		 */
+		static void coalesce(PendingWindow &pending, const dv::TimeWindow &window, const DataType &data) {
+			if (!pending.detached) {
+				for (auto &[key, value] : pending.data) {
+					value = std::visit(
+						[](const auto &store) {
+							return typename DataType::UnifiedType(detach(store));
+						}, value);
+				}
+				pending.detached = true;
+			}
+
+			for (const auto &[key, value] : data) {
+				std::visit(
+					[&pending, &key](const auto &store) {
+						using StoreType = std::decay_t<decltype(store)>;
+						if (!pending.data.contains(key)) {
+							pending.data[key] = StoreType();
+						}
+						auto &target = std::get<StoreType>(pending.data[key]);
+						if (store.isEmpty()) {
+							return;
+						}
+						// Detached shards are read-only, adding never merges into them
+						target.add(detach(target.isEmpty() ? store : store.sliceTime(target.getHighestTime() + 1)));
+					}, value);
+			}
+			pending.window.endTime = window.endTime;
+		}
+
+		void record(const Clock::time_point emitted) {
+			const auto latency = std::chrono::duration_cast<dv::Duration>(Clock::now() - emitted);
+			mStatistics.dispatched++;
+			mStatistics.lastLatency = latency;
+			mStatistics.maxLatency  = std::max(mStatistics.maxLatency, latency);
+			mStatistics.meanLatency = mStatistics.meanLatency
+				+ (latency - mStatistics.meanLatency) / static_cast<int64_t>(mStatistics.dispatched);
+		}
+
+		void drain() {
+			PendingWindow pending = [this] {
+				std::lock_guard<std::mutex> lock(mMutex);
+				PendingWindow front = std::move(mPending.front());
+				mPending.pop_front();
+				mStatistics.queueDepth = mPending.size();
+				return front;
+			}();
+			mCondition.notify_all();
+
+			std::exception_ptr error;
+			try {
+				mCallback(pending.window, pending.data);
+			} catch (...) {
+				error = std::current_exception();
+			}
+
+			std::unique_lock<std::mutex> lock(mMutex);
+			record(pending.emitted);
+			if (error != nullptr) {
+				if (mError == nullptr) {
+					mError = error;
+				}
+				mPending.clear();
+				mStatistics.queueDepth = 0;
+			}
+			if (mPending.empty()) {
+				mScheduled = false;
+				lock.unlock();
+				mCondition.notify_all();
+				return;
+			}
+
+			// Re-post instead of looping, so that other jobs get their turn on the pool
+			lock.unlock();
+			mPool->post([self = this->shared_from_this()] {
+				self->drain();
+			});
+		}
+
+	public:
+		explicit JobQueue(JobCallback callback) : mCallback(std::move(callback)) {
+		}
+
+		void configure(ThreadPool *pool, const size_t capacity, const BackpressurePolicy policy) {
+			wait();
+			std::lock_guard<std::mutex> lock(mMutex);
+			mPool     = pool;
+			mCapacity = std::max<size_t>(1, capacity);
+			mPolicy   = policy;
+		}
+
+		void push(const dv::TimeWindow &window, const DataType &data) {
+			if (mPool == nullptr) {
+				const auto emitted = Clock::now();
+				mCallback(window, data);
+				std::lock_guard<std::mutex> lock(mMutex);
+				record(emitted);
+				return;
+			}
+
+			std::unique_lock<std::mutex> lock(mMutex);
+			if (mPending.size() >= mCapacity) {
+				switch (mPolicy) {
+					case BackpressurePolicy::BLOCK:
+						mCondition.wait(lock, [this] {
+							return mPending.size() < mCapacity;
+						});
+						break;
+					case BackpressurePolicy::DROP_OLDEST:
+						mPending.pop_front();
+						mStatistics.dropped++;
+						break;
+					case BackpressurePolicy::COALESCE:
+						coalesce(mPending.back(), window, data);
+						mStatistics.coalesced++;
+						return;
+				}
+			}
+
+			mPending.push_back(PendingWindow{window, data, Clock::now(), false});
+			mStatistics.queueDepth    = mPending.size();
+			mStatistics.maxQueueDepth = std::max(mStatistics.maxQueueDepth, mPending.size());
+			if (mScheduled) {
+				return;
+			}
+
+			mScheduled = true;
+			lock.unlock();
+			mPool->post([self = this->shared_from_this()] {
+				self->drain();
+			});
+		}
+
+		void wait() {
+			std::unique_lock<std::mutex> lock(mMutex);
+			mCondition.wait(lock, [this] {
+				return mPending.empty() && !mScheduled;
+			});
+		}
+
+		/**
+		 * @brief Rethrow the error an asynchronous callback failed with, once.
+		 */
+		void rethrowError() {
+			std::exception_ptr error;
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				error = std::exchange(mError, nullptr);
+			}
+			if (error != nullptr) {
+				std::rethrow_exception(error);
+			}
+		}
+
+		[[nodiscard]] JobStatistics statistics() const {
+			std::lock_guard<std::mutex> lock(mMutex);
+			return mStatistics;
+		}
+	};
+
+    class SliceJob : public internal::SliceJobBase {
 		using JobCallback = std::function<void(const dv::TimeWindow &, const DataType &)>;
 
 	private:
-		DataType mData;
-        std::string  mReference;
-		JobCallback  mCallback;
-		int64_t mTimeInterval 	= -1;
-		int64_t mLastCallTime 	= 0;
-		size_t 	mNumberInterval = 0;
-		size_t 	mLastCallNumber = 0;
+		std::shared_ptr<JobQueue> mQueue;
+		/** Stream providing the window boundaries, and its next unused element */
+		std::string   mBoundary;
+		StorageCursor mBoundaryCursor;
+		/** Data kept by a bounded job waiting for its first boundary element */
+		int64_t mMaxLookback = 10000000;
+		/** Density of the open window, accumulated up to the scan cursor */
+		double 	mThreshold 		= 0.;
+		int64_t mMinDuration 	= 0;
+		int64_t mMaxDuration 	= 0;
+		double 	mDensity 		= 0.;
+		std::optional<int64_t> mCloseTime;
+		StorageCursor mScanCursor;
+		/** Event counts per cell for the density measure, only touched cells are reset */
+		cv::Size mResolution;
+		int 	 mCellSize 		= 1;
+		std::vector<uint32_t> mCells;
+		std::vector<size_t>   mTouchedCells;
+
+		/**
+		 * @brief Window spanned by the next boundary element, together with the
+		 * earliest time the window after it can start.
+		 */
+		[[nodiscard]] std::optional<std::pair<dv::TimeWindow, int64_t>> nextBoundary(const DataType &buffer) const {
+			return std::visit(
+				[this](const auto &store) -> std::optional<std::pair<dv::TimeWindow, int64_t>> {
+					using ElementType = typename std::decay_t<decltype(store)>::value_type;
+
+					const size_t index = store.cursorIndex(mBoundaryCursor);
+					if (index >= store.size()) {
+						return std::nullopt;
+					}
+
+					int64_t startTime = 0;
+					if constexpr (dv::concepts::TimestampedByAccessor<ElementType>) {
+						startTime = store.at(index).timestamp();
+					} else {
+						startTime = store.at(index).timestamp;
+					}
+
+					std::optional<int64_t> followTime = std::nullopt;
+					if (index + 1 < store.size()) {
+						if constexpr (dv::concepts::TimestampedByAccessor<ElementType>) {
+							followTime = store.at(index + 1).timestamp();
+						} else {
+							followTime = store.at(index + 1).timestamp;
+						}
+					}
+
+					if (mType == SliceType::EXPOSURE) {
+						if constexpr (std::is_same_v<ElementType, dv::Frame>) {
+							const auto endTime = startTime + store.at(index).exposure.count();
+							return std::make_pair(dv::TimeWindow(startTime, endTime), followTime.value_or(startTime));
+						} else {
+							throw std::invalid_argument("Exposure based slicing job requires a frame stream as boundary");
+						}
+					}
+
+					if (!followTime.has_value()) {
+						return std::nullopt;
+					}
+					return std::make_pair(dv::TimeWindow(startTime, *followTime), *followTime);
+				}, buffer.at(mBoundary));
+		}
+
+		void emitDensity(const DataType &buffer, const int64_t endTime) {
+			DataType slice;
+			sliceStreams(buffer, slice, mLastCallTime, endTime, endTime, "");
+			mQueue->push(dv::TimeWindow(mLastCallTime, endTime), slice);
+
+			mLastCallTime = endTime;
+			mDensity      = 0.;
+			mCloseTime    = std::nullopt;
+			for (const auto cell : mTouchedCells) {
+				mCells[cell] = 0;
+			}
+			mTouchedCells.clear();
+		}
+
+		template<class ElementType>
+		void accumulate(const ElementType &element) {
+			if constexpr (std::is_same_v<ElementType, dv::Event>) {
+				if (element.x() < 0 || element.y() < 0 || element.x() >= mResolution.width
+					|| element.y() >= mResolution.height) {
+					return;
+				}
+
+				const auto columns = static_cast<size_t>((mResolution.width + mCellSize - 1) / mCellSize);
+				const auto cell    = static_cast<size_t>(element.y() / mCellSize) * columns
+								   + static_cast<size_t>(element.x() / mCellSize);
+				if (mCells[cell]++ == 0) {
+					mTouchedCells.push_back(cell);
+				}
+				mDensity = std::max(mDensity, static_cast<double>(mCells[cell]));
+			} else {
+				throw std::invalid_argument("Density based slicing job requires an event stream as reference");
+			}
+		}
+
+		/**
+		 * @brief Walk the reference elements that arrived since the last call and
+		 * close windows when the density crosses the threshold or the window
+		 * reaches its maximum duration.
+		 */
+		void runDensity(const DataType &buffer) {
+			std::visit(
+				[this, &buffer](const auto &store) {
+					size_t scanned = 0;
+					for (auto itr = store.cursorIterator(mScanCursor); itr != store.end(); ++itr, ++scanned) {
+						int64_t timestamp = 0;
+						if constexpr (dv::concepts::TimestampedByAccessor<typename std::decay_t<decltype(store)>::value_type>) {
+							timestamp = itr->timestamp();
+						} else {
+							timestamp = itr->timestamp;
+						}
+
+						// Elements sharing the timestamp of the triggering one stay in its window
+						if (mCloseTime.has_value() && timestamp >= *mCloseTime) {
+							emitDensity(buffer, *mCloseTime);
+						}
+
+						while (timestamp - mLastCallTime >= mMaxDuration) {
+							if (mDensity > 0.) {
+								emitDensity(buffer, mLastCallTime + mMaxDuration);
+							} else {
+								// Skip quiet periods instead of emitting empty windows
+								mLastCallTime = timestamp;
+							}
+						}
+
+						accumulate(*itr);
+						if (!mCloseTime.has_value() && mDensity >= mThreshold
+							&& timestamp - mLastCallTime >= mMinDuration) {
+							mCloseTime = timestamp + 1;
+						}
+					}
+					mScanCursor = store.advanceCursor(mScanCursor, scanned);
+				}, buffer.at(mReference));
+		}
 
     public:
         enum class SliceType {
             NUMBER,
-            TIME
+            TIME,
+            /** Windows span the exposure of each frame of the boundary stream */
+            EXPOSURE,
+            /** Windows span consecutive elements of the boundary stream */
+            BOUNDARY,
+            /** Windows close once enough events fall into a single cell */
+            DENSITY
         } mType;
 
         SliceJob() = default;
@@ -31,61 +933,191 @@ protected:
 		SliceJob(
 			const std::string & name, const SliceType type, 
             const int64_t timeInterval, const size_t numberInterval, JobCallback callback) :
-			mReference(name),
-            mType(type),
-			mCallback(std::move(callback)),
-			mTimeInterval(timeInterval),
-			mNumberInterval(numberInterval),
-			mLastCallTime(0),
-			mLastCallNumber(0) {
+			SliceJob(name, type, timeInterval, timeInterval, numberInterval, numberInterval, std::move(callback)) {
+		}
+
+		SliceJob(
+			const std::string & name, const SliceType type, const int64_t timeInterval, const int64_t timeStride,
+			const size_t numberInterval, const size_t numberStride, JobCallback callback) :
+			internal::SliceJobBase(name, timeInterval, timeStride, numberInterval, numberStride),
+			mQueue(std::make_shared<JobQueue>(std::move(callback))),
+            mType(type) {
+			if (type == SliceType::TIME && timeStride <= 0) {
+				throw std::invalid_argument("Time based slicing job requires a positive stride");
+			}
+			if (type == SliceType::NUMBER && numberStride == 0) {
+				throw std::invalid_argument("Number based slicing job requires a positive stride");
+			}
+		}
+
+		SliceJob(const std::string &name, const SliceType type, const std::string &boundary, JobCallback callback) :
+			internal::SliceJobBase(name, -1, -1, 0, 0),
+			mQueue(std::make_shared<JobQueue>(std::move(callback))),
+			mBoundary(boundary),
+            mType(type) {
+			if (type != SliceType::EXPOSURE && type != SliceType::BOUNDARY) {
+				throw std::invalid_argument("Only exposure or boundary based slicing jobs take a boundary stream");
+			}
+		}
+
+		SliceJob(const std::string &name, const double threshold, const int64_t minDuration, const int64_t maxDuration,
+			const cv::Size &resolution, const int cellSize, JobCallback callback) :
+			internal::SliceJobBase(name, -1, -1, 0, 0),
+			mQueue(std::make_shared<JobQueue>(std::move(callback))),
+			mThreshold(threshold),
+			mMinDuration(minDuration),
+			mMaxDuration(maxDuration),
+			mResolution(resolution),
+			mCellSize(cellSize),
+            mType(SliceType::DENSITY) {
+			if (maxDuration <= 0 || minDuration > maxDuration) {
+				throw std::invalid_argument("Density based slicing job requires 0 < minimum duration <= maximum duration");
+			}
+			if (resolution.area() <= 0) {
+				throw std::invalid_argument("Density based slicing job requires a valid resolution");
+			}
+			if (cellSize <= 0) {
+				throw std::invalid_argument("Density based slicing job requires a positive cell size");
+			}
+			const auto columns = static_cast<size_t>((resolution.width + cellSize - 1) / cellSize);
+			const auto rows    = static_cast<size_t>((resolution.height + cellSize - 1) / cellSize);
+			mCells.assign(columns * rows, 0);
 		}
 
-		void run(const DataType &data) {
-			if (data.size(mReference) == 0) {
+		/**
+		 * @brief Bounded jobs only follow the tail of their boundary stream, the
+		 * first window may still cover data buffered before its boundary arrived.
+		 * That data is limited to the last `mMaxLookback` of every other stream, so
+		 * a late or missing boundary stream does not pin the whole buffer.
+		 */
+		void prepare(const DataType &buffer) {
+			if (mType != SliceType::EXPOSURE && mType != SliceType::BOUNDARY) {
+				internal::SliceJobBase::prepare(buffer);
+				return;
+			}
+			if (mStarted) {
 				return;
 			}
 
-			mData.add(data);
-			if (mLastCallTime == 0) {
-				mLastCallTime = mData.timeWindow(mReference).startTime;
+			for (const auto &[key, value] : buffer) {
+				if (key == mBoundary) {
+					followTail(buffer, mBoundary);
+					continue;
+				}
+				std::visit(
+					[this, &key](const auto &store) {
+						if (!store.isEmpty()) {
+							auto &current = cursor(key);
+							current = store.advanceCursorToTime(current, store.getHighestTime() - mMaxLookback);
+						}
+					}, value);
 			}
+		}
 
-			if (mType == SliceType::NUMBER) {
-				while (mData.size(mReference) - mLastCallNumber >= mNumberInterval) {
-					DataType slice;
-					slice = mData.sliceByNumber(mReference, mLastCallNumber, mNumberInterval);
-					mLastCallTime	= slice.timeWindow(mReference).endTime;
-					mLastCallNumber = mLastCallNumber + mNumberInterval;
-					mCallback(slice.timeWindow(mReference), slice);
+		void run(const DataType &buffer) {
+			const bool bounded = (mType == SliceType::EXPOSURE || mType == SliceType::BOUNDARY);
+			if (!mStarted) {
+				if (!start(buffer, bounded ? mBoundary : mReference)) {
+					return;
+				}
+				if (bounded) {
+					mBoundaryCursor = cursor(mBoundary);
 				}
+				mScanCursor = cursor(mReference);
 			}
 
-			if (mType == SliceType::TIME) {
-				while (mData.timeWindow(mReference).endTime - mLastCallTime >= mTimeInterval) {
+			if (mType == SliceType::DENSITY) {
+				runDensity(buffer);
+			}
+
+			if (bounded) {
+				// A window is complete once the reference stream has moved past its end
+				while (const auto boundary = nextBoundary(buffer)) {
+					const auto &[timeWindow, followTime] = *boundary;
+					if (buffer.timeWindow(mReference).endTime < timeWindow.endTime) {
+						break;
+					}
+
 					DataType slice;
-					slice = mData.sliceByTime(mReference, mLastCallTime, mLastCallTime + mTimeInterval);
-					mLastCallTime = mLastCallTime + mTimeInterval;
-					mLastCallNumber = mLastCallNumber + slice.size(mReference);
-					mCallback(slice.timeWindow(mReference), slice);
+					sliceStreams(buffer, slice, timeWindow.startTime, timeWindow.endTime,
+						std::min(followTime, timeWindow.endTime), "");
+					mBoundaryCursor = std::visit(
+						[this](const auto &store) {
+							return store.advanceCursor(mBoundaryCursor, 1);
+						}, buffer.at(mBoundary));
+					mLastCallTime = timeWindow.endTime;
+					mQueue->push(timeWindow, slice);
 				}
 			}
 
-			size_t length = mData.size(mReference) - mLastCallNumber;
-			mData = mData.sliceByNumber(mReference, mLastCallNumber, length);
-			mLastCallNumber = 0;
+			const auto emit = [this](const dv::TimeWindow &timeWindow, const DataType &slice) {
+				mQueue->push(timeWindow, slice);
+			};
+			if (mType == SliceType::NUMBER) {
+				runNumber(buffer, emit);
+			}
+			if (mType == SliceType::TIME) {
+				runTime(buffer, emit);
+			}
+		}
+
+		[[nodiscard]] size_t consumedPartials(const std::string &name) const {
+			const size_t consumed = internal::SliceJobBase::consumedPartials(name);
+			if (mStarted && name == mBoundary) {
+				return std::min(consumed, mBoundaryCursor.partialIndex);
+			}
+			if (mStarted && name == mReference) {
+				return std::min(consumed, mScanCursor.partialIndex);
+			}
+			return consumed;
+		}
+
+		void rebase(const std::string &name, const size_t releasedPartials) {
+			internal::SliceJobBase::rebase(name, releasedPartials);
+			if (mStarted && name == mBoundary) {
+				mBoundaryCursor.partialIndex -= releasedPartials;
+			}
+			if (mStarted && name == mReference) {
+				mScanCursor.partialIndex -= releasedPartials;
+			}
+		}
+
+		[[nodiscard]] JobQueue &queue() {
+			return *mQueue;
+		}
+
+		[[nodiscard]] const JobQueue &queue() const {
+			return *mQueue;
 		}
 
 		void setTimeInterval(const int64_t timeInterval) {
 			if (mType != SliceType::TIME) {
 				throw std::invalid_argument("Setting a new number interval to a time based slicing job");
 			}
+			// Back-to-back windows stay back-to-back
+			if (mTimeStride == mTimeInterval) {
+				mTimeStride = timeInterval;
+			}
 			mTimeInterval = timeInterval;
 		}
 
+		void setMaxLookback(const int64_t maxLookback) {
+			if (mType != SliceType::EXPOSURE && mType != SliceType::BOUNDARY) {
+				throw std::invalid_argument("Only exposure or boundary based slicing jobs have a lookback");
+			}
+			if (maxLookback < 0) {
+				throw std::invalid_argument("Lookback must not be negative");
+			}
+			mMaxLookback = maxLookback;
+		}
+
 		void setNumberInterval(const size_t numberInterval) {
 			if (mType != SliceType::NUMBER) {
 				throw std::invalid_argument("Setting a new time interval to a number based slicing job");
 			}
+			if (mNumberStride == mNumberInterval) {
+				mNumberStride = numberInterval;
+			}
 			mNumberInterval = numberInterval;
 		}
     };
@@ -93,14 +1125,64 @@ protected:
 private:
     int32_t mHashCounter = 0;
 	std::map<int, SliceJob> mSliceJobs;
+	/** Ingest buffer shared by all jobs, shards are reference counted so emitted slices outlive it */
+	DataType mData;
+	size_t mQueueCapacity = 16;
+	BackpressurePolicy mPolicy = BackpressurePolicy::BLOCK;
+	/** Declared last, so pending callbacks are executed before the jobs are destroyed */
+	std::unique_ptr<ThreadPool> mPool;
+
+	int addJob(SliceJob job) {
+		mHashCounter += 1;
+		job.queue().configure(mPool.get(), mQueueCapacity, mPolicy);
+		mSliceJobs.emplace(std::make_pair(mHashCounter, std::move(job)));
+		return mHashCounter;
+	}
+
+	void rethrowErrors() {
+		for (auto &jobTuple : mSliceJobs) {
+			jobTuple.second.queue().rethrowError();
+		}
+	}
+
+	void releaseConsumed() {
+		internal::releaseConsumed(
+			mData,
+			[this](const std::string &key) {
+				size_t consumed = std::numeric_limits<size_t>::max();
+				for (const auto &jobTuple : mSliceJobs) {
+					consumed = std::min(consumed, jobTuple.second.consumedPartials(key));
+				}
+				return consumed;
+			},
+			[this](const std::string &key, const size_t released) {
+				for (auto &jobTuple : mSliceJobs) {
+					jobTuple.second.rebase(key, released);
+				}
+			});
+	}
 
 public:
     DataSlicer() = default;
 
 	void accept(const DataType &data) {
+		if (mSliceJobs.empty()) {
+			return;
+		}
+
+		for (auto &jobTuple : mSliceJobs) {
+			jobTuple.second.prepare(mData);
+		}
+
+		// New data is merged once, whatever the number of registered jobs
+		mData.add(data);
 		for (auto &jobTuple : mSliceJobs) {
-			jobTuple.second.run(data);
+			jobTuple.second.run(mData);
 		}
+
+		// Shards are dropped once every job has passed them
+		releaseConsumed();
+		rethrowErrors();
 	}
 
 	int doEveryNumberOfElements(
@@ -114,10 +1196,26 @@ public:
 	int doEveryNumberOfElements(
 		const std::string &name, const size_t n,
 		std::function<void(const dv::TimeWindow &, const DataType &)> callback) {
-		mHashCounter += 1;
-		mSliceJobs.emplace(std::make_pair(
-			mHashCounter, SliceJob(name, SliceJob::SliceType::NUMBER, 0, n, callback)));
-		return mHashCounter;
+		return addJob(SliceJob(name, SliceJob::SliceType::NUMBER, 0, n, std::move(callback)));
+	}
+
+	/**
+	 * @brief Register a callback on windows of `n` elements of the reference stream,
+	 * started every `stride` elements. Overlapping windows share their shards, the
+	 * overlap is not copied.
+	 */
+	int doEveryNumberOfElements(
+		const std::string &name, const size_t n, const size_t stride,
+		std::function<void(const DataType &)> callback) {
+		return doEveryNumberOfElements(name, n, stride, [callback](const dv::TimeWindow &, const DataType &data) {
+			callback(data);
+		});
+	}
+
+	int doEveryNumberOfElements(
+		const std::string &name, const size_t n, const size_t stride,
+		std::function<void(const dv::TimeWindow &, const DataType &)> callback) {
+		return addJob(SliceJob(name, SliceJob::SliceType::NUMBER, 0, 0, n, stride, std::move(callback)));
 	}
 
 	int doEveryTimeInterval(
@@ -131,12 +1229,101 @@ public:
 	int doEveryTimeInterval(
 		const std::string &name, const dv::Duration interval, 
         std::function<void(const dv::TimeWindow &, const DataType &)> callback) {
-        mHashCounter += 1;
-		mSliceJobs.emplace(std::make_pair(
-            mHashCounter, SliceJob(name, SliceJob::SliceType::TIME, interval.count(), 0, callback)));
-        return mHashCounter;
+		return addJob(SliceJob(name, SliceJob::SliceType::TIME, interval.count(), 0, std::move(callback)));
     }
 
+	/**
+	 * @brief Register a callback on windows of `window` duration of the reference
+	 * stream, started every `stride`. Overlapping windows share their shards, the
+	 * overlap is not copied.
+	 */
+	int doEveryTimeInterval(
+		const std::string &name, const dv::Duration window, const dv::Duration stride,
+		std::function<void(const DataType &)> callback) {
+		return doEveryTimeInterval(name, window, stride, [callback](const dv::TimeWindow &, const DataType &data) {
+			callback(data);
+		});
+	}
+
+	int doEveryTimeInterval(
+		const std::string &name, const dv::Duration window, const dv::Duration stride,
+		std::function<void(const dv::TimeWindow &, const DataType &)> callback) {
+		return addJob(SliceJob(
+			name, SliceJob::SliceType::TIME, window.count(), stride.count(), 0, 0, std::move(callback)));
+	}
+
+	/**
+	 * @brief Register a callback on the exposure of every frame of a frame stream,
+	 * i.e. [timestamp, timestamp + exposure). A window is emitted once the
+	 * reference stream has passed its end. Until the first frame arrives, only the
+	 * last 10 seconds of the other streams are kept, see modifyMaxLookback().
+	 * 
+	 * @param name Reference stream that has to cover a window before it is emitted.
+	 * @param frames Frame stream providing the exposure windows.
+	 */
+	int doEveryFrameExposure(
+		const std::string &name, const std::string &frames,
+		std::function<void(const DataType &)> callback) {
+		return doEveryFrameExposure(name, frames, [callback](const dv::TimeWindow &, const DataType &data) {
+			callback(data);
+		});
+	}
+
+	int doEveryFrameExposure(
+		const std::string &name, const std::string &frames,
+		std::function<void(const dv::TimeWindow &, const DataType &)> callback) {
+		return addJob(SliceJob(name, SliceJob::SliceType::EXPOSURE, frames, std::move(callback)));
+	}
+
+	/**
+	 * @brief Register a callback on the interval between every two consecutive
+	 * elements of a boundary stream (e.g. triggers), i.e. [t_i, t_i+1). A window
+	 * is emitted once the reference stream has passed its end. Until the first
+	 * boundary element arrives, only the last 10 seconds of the other streams
+	 * are kept, see modifyMaxLookback().
+	 * 
+	 * @param name Reference stream that has to cover a window before it is emitted.
+	 * @param boundary Stream whose timestamps delimit the windows.
+	 */
+	int doEveryBoundaryInterval(
+		const std::string &name, const std::string &boundary,
+		std::function<void(const DataType &)> callback) {
+		return doEveryBoundaryInterval(name, boundary, [callback](const dv::TimeWindow &, const DataType &data) {
+			callback(data);
+		});
+	}
+
+	int doEveryBoundaryInterval(
+		const std::string &name, const std::string &boundary,
+		std::function<void(const dv::TimeWindow &, const DataType &)> callback) {
+		return addJob(SliceJob(name, SliceJob::SliceType::BOUNDARY, boundary, std::move(callback)));
+	}
+
+	/**
+	 * @brief Register a callback on windows that adapt to the local event density
+	 * of the reference event stream. The sensor is split into square cells of
+	 * `cellSize` pixels, a window closes once a single cell received `threshold`
+	 * events and the window lasts at least `minDuration`, or when it reaches
+	 * `maxDuration`.
+	 */
+	int doEveryEventDensity(
+		const std::string &name, const cv::Size &resolution, const int cellSize, const double threshold,
+		const dv::Duration minDuration, const dv::Duration maxDuration,
+		std::function<void(const DataType &)> callback) {
+		return doEveryEventDensity(name, resolution, cellSize, threshold, minDuration, maxDuration,
+			[callback](const dv::TimeWindow &, const DataType &data) {
+				callback(data);
+			});
+	}
+
+	int doEveryEventDensity(
+		const std::string &name, const cv::Size &resolution, const int cellSize, const double threshold,
+		const dv::Duration minDuration, const dv::Duration maxDuration,
+		std::function<void(const dv::TimeWindow &, const DataType &)> callback) {
+		return addJob(SliceJob(
+			name, threshold, minDuration.count(), maxDuration.count(), resolution, cellSize, std::move(callback)));
+	}
+
 	[[nodiscard]] bool hasJob(const int jobId) const {
 		return mSliceJobs.contains(jobId);
 	}
@@ -145,9 +1332,64 @@ public:
 		if (!hasJob(jobId)) {
 			return;
 		}
+		mSliceJobs[jobId].queue().wait();
 		mSliceJobs.erase(jobId);
 	}
 
+	/**
+	 * @brief Run job callbacks on a thread pool instead of the accepting thread.
+	 * Each job gets a queue of the given capacity, windows of a job are still
+	 * delivered in order.
+	 * 
+	 * @param numThreads Number of worker threads.
+	 * @param queueCapacity Maximum number of pending windows per job.
+	 * @param policy What to do when a job queue is full.
+	 */
+	void enableAsyncDispatch(const size_t numThreads, const size_t queueCapacity = 16,
+		const BackpressurePolicy policy = BackpressurePolicy::BLOCK) {
+		disableAsyncDispatch();
+
+		mPool          = std::make_unique<ThreadPool>(numThreads);
+		mQueueCapacity = queueCapacity;
+		mPolicy        = policy;
+		for (auto &jobTuple : mSliceJobs) {
+			jobTuple.second.queue().configure(mPool.get(), mQueueCapacity, mPolicy);
+		}
+	}
+
+	/**
+	 * @brief Wait for all pending callbacks and go back to calling them on the accepting thread.
+	 */
+	void disableAsyncDispatch() {
+		for (auto &jobTuple : mSliceJobs) {
+			jobTuple.second.queue().configure(nullptr, mQueueCapacity, mPolicy);
+		}
+		mPool.reset();
+	}
+
+	[[nodiscard]] bool isAsyncDispatch() const {
+		return mPool != nullptr;
+	}
+
+	/**
+	 * @brief Block until every window emitted so far went through its callback.
+	 * The first error of an asynchronous callback since the last call to accept()
+	 * or flush() is rethrown here.
+	 */
+	void flush() {
+		for (auto &jobTuple : mSliceJobs) {
+			jobTuple.second.queue().wait();
+		}
+		rethrowErrors();
+	}
+
+	[[nodiscard]] std::optional<JobStatistics> getJobStatistics(const int jobId) const {
+		if (!hasJob(jobId)) {
+			return std::nullopt;
+		}
+		return mSliceJobs.at(jobId).queue().statistics();
+	}
+
 	void modifyTimeInterval(const int jobId, const dv::Duration timeInterval) {
 		if (!hasJob(jobId)) {
 			return;
@@ -161,8 +1403,190 @@ public:
 		}
 		mSliceJobs[jobId].setNumberInterval(numberInterval);
 	}
+
+	/**
+	 * @brief Duration of data an exposure or boundary job keeps while it waits for
+	 * the first element of its boundary stream. The first window only covers data
+	 * that recent, older shards are released for all jobs. Defaults to 10 seconds.
+	 */
+	void modifyMaxLookback(const int jobId, const dv::Duration maxLookback) {
+		if (!hasJob(jobId)) {
+			return;
+		}
+		mSliceJobs[jobId].setMaxLookback(maxLookback.count());
+	}
 };
 
 using MonoCameraSlicer = DataSlicer<MonoCameraData>;
 
+/**
+ * @brief Slices several cameras jointly on their common time base, given by the
+ * clock models of the accepted data. A window is emitted once the reference
+ * stream of every camera has passed its end.
+ */
+class MultiCameraSlicer {
+	using JobCallback = std::function<void(const dv::TimeWindow &, const MultiCameraData &)>;
+
+	/** Cursors into the streams of a single camera, moved at the local time of the camera */
+	class CameraCursors : public internal::SliceJobBase {
+	public:
+		using internal::SliceJobBase::nextTime;
+		using internal::SliceJobBase::sliceStreams;
+	};
+
+	struct SliceJob {
+		std::string reference;
+		int64_t timeInterval = 0;
+		int64_t timeStride   = 0;
+		JobCallback callback;
+		bool started         = false;
+		/** Start of the next window in common time */
+		int64_t nextTime     = 0;
+		std::unordered_map<std::string, CameraCursors> cameras;
+	};
+
+private:
+	int32_t mHashCounter = 0;
+	std::map<int, SliceJob> mSliceJobs;
+	/** Ingest buffer shared by all jobs, shards are reference counted so emitted slices outlive it */
+	MultiCameraData mData;
+
+	/**
+	 * @brief Jobs that have not seen the reference stream of every camera yet
+	 * only follow the tail of the buffer, so they neither replay nor pin older data.
+	 */
+	void prepare(SliceJob &job) {
+		if (job.started) {
+			return;
+		}
+		for (const auto &[key, value] : mData) {
+			job.cameras[key].prepare(value);
+		}
+	}
+
+	void run(SliceJob &job) {
+		if (mData.empty()) {
+			return;
+		}
+
+		std::optional<int64_t> startTime;
+		int64_t progress = std::numeric_limits<int64_t>::max();
+		for (const auto &[key, value] : mData) {
+			if (value.size(job.reference) == 0) {
+				return;
+			}
+			const auto clock = mData.clock(key);
+			progress         = std::min(progress, clock.toCommon(value.timeWindow(job.reference).endTime));
+			if (!job.started) {
+				const auto time = job.cameras[key].nextTime(value, job.reference);
+				if (!time.has_value()) {
+					return;
+				}
+				startTime = std::min(startTime.value_or(std::numeric_limits<int64_t>::max()), clock.toCommon(*time));
+			}
+		}
+
+		if (!job.started) {
+			job.started  = true;
+			job.nextTime = *startTime;
+		}
+
+		while (progress - job.nextTime >= job.timeInterval) {
+			const dv::TimeWindow window(job.nextTime, job.nextTime + job.timeInterval);
+			job.nextTime += job.timeStride;
+
+			MultiCameraData slice;
+			for (const auto &[key, value] : mData) {
+				const auto clock = mData.clock(key);
+				job.cameras[key].sliceStreams(value, slice[key], clock.toLocal(window.startTime),
+					clock.toLocal(window.endTime), clock.toLocal(job.nextTime), "");
+				slice.setClock(key, clock);
+			}
+			job.callback(window, slice);
+		}
+	}
+
+	/** Drop shards every job has passed, per camera */
+	void releaseConsumed() {
+		for (auto &[camera, value] : mData) {
+			internal::releaseConsumed(
+				value,
+				[this, &camera](const std::string &key) {
+					size_t consumed = std::numeric_limits<size_t>::max();
+					for (auto &jobTuple : mSliceJobs) {
+						consumed = std::min(consumed, jobTuple.second.cameras[camera].consumedPartials(key));
+					}
+					return consumed;
+				},
+				[this, &camera](const std::string &key, const size_t released) {
+					for (auto &jobTuple : mSliceJobs) {
+						jobTuple.second.cameras[camera].rebase(key, released);
+					}
+				});
+		}
+	}
+
+public:
+	MultiCameraSlicer() = default;
+
+	void accept(const MultiCameraData &data) {
+		if (mSliceJobs.empty()) {
+			return;
+		}
+
+		for (auto &jobTuple : mSliceJobs) {
+			prepare(jobTuple.second);
+		}
+
+		mData.add(data);
+		for (auto &jobTuple : mSliceJobs) {
+			run(jobTuple.second);
+		}
+		releaseConsumed();
+	}
+
+	/**
+	 * @brief Emit windows of common time every `stride`, the reference stream of
+	 * every camera has to cover a window before it is emitted.
+	 */
+	int doEveryTimeInterval(const std::string &name, const dv::Duration interval, const dv::Duration stride,
+		std::function<void(const dv::TimeWindow &, const MultiCameraData &)> callback) {
+		if (interval.count() <= 0 || stride.count() <= 0) {
+			throw std::invalid_argument("Time interval and stride must be greater than zero");
+		}
+
+		SliceJob job;
+		job.reference    = name;
+		job.timeInterval = interval.count();
+		job.timeStride   = stride.count();
+		job.callback     = std::move(callback);
+
+		mHashCounter += 1;
+		mSliceJobs.emplace(mHashCounter, std::move(job));
+		return mHashCounter;
+	}
+
+	int doEveryTimeInterval(const std::string &name, const dv::Duration interval,
+		std::function<void(const dv::TimeWindow &, const MultiCameraData &)> callback) {
+		return doEveryTimeInterval(name, interval, interval, std::move(callback));
+	}
+
+	int doEveryTimeInterval(const std::string &name, const dv::Duration interval,
+		std::function<void(const MultiCameraData &)> callback) {
+		return doEveryTimeInterval(name, interval, [callback](const dv::TimeWindow &, const MultiCameraData &data) {
+			callback(data);
+		});
+	}
+
+	[[nodiscard]] bool hasJob(const int jobId) const {
+		return mSliceJobs.contains(jobId);
+	}
+
+	void removeJob(const int jobId) {
+		mSliceJobs.erase(jobId);
+	}
+};
+
+using StereoCameraSlicer = MultiCameraSlicer;
+
 } // namespace dv::toolkit
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "./slicer.hpp"
+
+#include <tuple>
+
+namespace dv::toolkit {
+
+namespace internal {
+
+/** Callbacks may take the window along with the data */
+template<class Callback, class DataType>
+inline void invoke(Callback &callback, const dv::TimeWindow &window, const DataType &data) {
+	if constexpr (std::is_invocable_v<Callback &, const dv::TimeWindow &, const DataType &>) {
+		callback(window, data);
+	} else {
+		callback(data);
+	}
+}
+
+} // namespace internal
+
+/**
+ * @brief Statically typed job emitting windows of a fixed duration every `stride`.
+ */
+template<class Callback>
+class TimeIntervalJob : public internal::SliceJobBase {
+private:
+	Callback mCallback;
+
+public:
+	TimeIntervalJob(std::string reference, const dv::Duration interval, const dv::Duration stride, Callback callback) :
+		internal::SliceJobBase(std::move(reference), interval.count(), stride.count(), 0, 0),
+		mCallback(std::move(callback)) {
+		if (mTimeInterval <= 0 || mTimeStride <= 0) {
+			throw std::invalid_argument("Time interval and stride must be greater than zero");
+		}
+	}
+
+	template<class DataType>
+	void run(const internal::StreamLayout<DataType> &streams) {
+		if (!mStarted && !start(streams)) {
+			return;
+		}
+
+		runTime(streams, [this](const dv::TimeWindow &window, const DataType &slice) {
+			internal::invoke(mCallback, window, slice);
+		});
+	}
+
+	[[nodiscard]] Callback &callback() noexcept {
+		return mCallback;
+	}
+};
+
+/**
+ * @brief Statically typed job emitting windows of a fixed number of reference
+ * elements every `stride` elements.
+ */
+template<class Callback>
+class NumberIntervalJob : public internal::SliceJobBase {
+private:
+	Callback mCallback;
+
+public:
+	NumberIntervalJob(std::string reference, const size_t n, const size_t stride, Callback callback) :
+		internal::SliceJobBase(std::move(reference), -1, -1, n, stride),
+		mCallback(std::move(callback)) {
+		if (mNumberInterval == 0 || mNumberStride == 0) {
+			throw std::invalid_argument("Number interval and stride must be greater than zero");
+		}
+	}
+
+	template<class DataType>
+	void run(const internal::StreamLayout<DataType> &streams) {
+		if (!mStarted && !start(streams)) {
+			return;
+		}
+
+		runNumber(streams, [this](const dv::TimeWindow &window, const DataType &slice) {
+			internal::invoke(mCallback, window, slice);
+		});
+	}
+
+	[[nodiscard]] Callback &callback() noexcept {
+		return mCallback;
+	}
+};
+
+template<class Callback>
+[[nodiscard]] inline auto everyTimeInterval(
+	std::string name, const dv::Duration interval, const dv::Duration stride, Callback &&callback) {
+	return TimeIntervalJob<std::decay_t<Callback>>(std::move(name), interval, stride, std::forward<Callback>(callback));
+}
+
+template<class Callback>
+[[nodiscard]] inline auto everyTimeInterval(std::string name, const dv::Duration interval, Callback &&callback) {
+	return everyTimeInterval(std::move(name), interval, interval, std::forward<Callback>(callback));
+}
+
+template<class Callback>
+[[nodiscard]] inline auto everyNumberOfElements(std::string name, const size_t n, const size_t stride, Callback &&callback) {
+	return NumberIntervalJob<std::decay_t<Callback>>(std::move(name), n, stride, std::forward<Callback>(callback));
+}
+
+template<class Callback>
+[[nodiscard]] inline auto everyNumberOfElements(std::string name, const size_t n, Callback &&callback) {
+	return everyNumberOfElements(std::move(name), n, n, std::forward<Callback>(callback));
+}
+
+/**
+ * @brief Slicer with a fixed set of jobs known at compile time. Jobs and their
+ * callables are stored by value in a tuple and dispatched without type erasure,
+ * so the per window path can be inlined. Windows match those of `DataSlicer`
+ * with the same configuration, callbacks always run on the accepting thread.
+ *
+ * Callbacks take either `(const DataType &)` or
+ * `(const dv::TimeWindow &, const DataType &)`.
+ */
+template<class DataType, class... Jobs>
+class StaticDataSlicer {
+private:
+	std::tuple<Jobs...> mJobs;
+	/** Ingest buffer shared by all jobs, shards are reference counted so emitted slices outlive it */
+	DataType mData;
+	/** Streams of the ingest buffer, jobs address them by the index resolved at registration */
+	internal::StreamLayout<DataType> mStreams;
+
+	void releaseConsumed() {
+		mStreams.forEach([this](const auto &stream) {
+			const size_t consumed = std::apply(
+				[&stream](const auto &...job) {
+					return std::min({std::numeric_limits<size_t>::max(), job.consumedPartials(stream.index)...});
+				}, mJobs);
+
+			const size_t released = std::min(consumed, stream.store->cursorEnd().partialIndex);
+			stream.store->releasePartials(released);
+			if (released == 0) {
+				return;
+			}
+			std::apply(
+				[&stream, released](auto &...job) {
+					(job.rebase(stream.index, released), ...);
+				}, mJobs);
+		});
+	}
+
+public:
+	explicit StaticDataSlicer(Jobs... jobs) : mJobs(std::move(jobs)...) {
+		std::apply(
+			[this](auto &...job) {
+				(job.bind(mStreams), ...);
+			}, mJobs);
+	}
+
+	void accept(const DataType &data) {
+		mStreams.resolve(mData);
+		std::apply(
+			[this](auto &...job) {
+				(job.prepare(mStreams), ...);
+			}, mJobs);
+
+		mData.add(data);
+		mStreams.resolve(mData);
+		std::apply(
+			[this](auto &...job) {
+				(job.run(mStreams), ...);
+			}, mJobs);
+
+		releaseConsumed();
+	}
+
+	template<size_t Index>
+	[[nodiscard]] auto &job() noexcept {
+		return std::get<Index>(mJobs);
+	}
+
+	[[nodiscard]] static constexpr size_t numberOfJobs() noexcept {
+		return sizeof...(Jobs);
+	}
+};
+
+template<class DataType, class... Jobs>
+[[nodiscard]] inline auto makeStaticSlicer(Jobs &&...jobs) {
+	return StaticDataSlicer<DataType, std::decay_t<Jobs>...>(std::forward<Jobs>(jobs)...);
+}
+
+} // namespace dv::toolkit
@@ -0,0 +1,357 @@
+#pragma once
+
+#include "../core/core.hpp"
+#include "./mmap.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+namespace dv::toolkit::io::cache {
+
+namespace internal {
+
+/**
+ * File layout, all integers in the native byte order of the writing machine:
+ *
+ *     FileHeader
+ *     StreamHeader x streamCount
+ *     shard data, every shard starting at a multiple of `alignment`
+ *     ShardHeader x shardCount, one table per stream
+ *
+ * Shards of events, IMUs and triggers are raw element arrays, frame shards are
+ * a sequence of FrameHeader followed by the pixels of the frame.
+ */
+constexpr char magic[8]    = {'D', 'V', 'T', 'K', 'C', 'A', 'C', 'H'};
+constexpr uint32_t version = 2;
+constexpr uint64_t alignment = 64;
+
+struct FileHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t streamCount;
+	/** Resolutions, zero when unknown */
+	int32_t eventWidth;
+	int32_t eventHeight;
+	int32_t frameWidth;
+	int32_t frameHeight;
+};
+
+struct StreamHeader {
+	char name[48];
+	/** Index of the storage type in `StandardCameraData::UnifiedType` */
+	uint32_t kind;
+	uint32_t elementSize;
+	uint64_t shardCount;
+	uint64_t shardTableOffset;
+};
+
+struct ShardHeader {
+	uint64_t offset;
+	uint64_t length;
+	uint64_t bytes;
+	/** Time range of the shard, so opening a file does not touch the elements */
+	int64_t lowestTime;
+	int64_t highestTime;
+};
+
+struct FrameHeader {
+	int64_t timestamp;
+	int64_t exposure;
+	int32_t rows;
+	int32_t cols;
+	int32_t type;
+	int16_t positionX;
+	int16_t positionY;
+	int8_t source;
+	int8_t padding[7];
+	uint64_t bytes;
+};
+
+class Writer {
+private:
+	std::unique_ptr<FILE, decltype(&std::fclose)> mFile;
+	std::string mPath;
+	uint64_t mPosition = 0;
+
+public:
+	explicit Writer(const std::filesystem::path &path) :
+		mFile(std::fopen(path.c_str(), "wb"), &std::fclose),
+		mPath(path.string()) {
+		if (mFile == nullptr) {
+			throw std::runtime_error("Failed to open " + mPath + " for writing");
+		}
+	}
+
+	void write(const void *data, const size_t bytes) {
+		if (bytes > 0 && std::fwrite(data, 1, bytes, mFile.get()) != bytes) {
+			throw std::runtime_error("Failed to write " + mPath);
+		}
+		mPosition += bytes;
+	}
+
+	void pad(const uint64_t multiple) {
+		static constexpr char zeros[alignment] = {};
+		write(zeros, (multiple - mPosition % multiple) % multiple);
+	}
+
+	void seek(const uint64_t position) {
+		if (fseeko(mFile.get(), static_cast<off_t>(position), SEEK_SET) != 0) {
+			throw std::runtime_error("Failed to write " + mPath);
+		}
+		mPosition = position;
+	}
+
+	[[nodiscard]] uint64_t position() const noexcept {
+		return mPosition;
+	}
+};
+
+template<class WriterType, class StorageType>
+[[nodiscard]] inline std::vector<ShardHeader> writeShards(WriterType &writer, const StorageType &store) {
+	using Type = typename StorageType::value_type;
+
+	std::vector<ShardHeader> shards;
+	shards.reserve(store.partials().size());
+	for (const auto &partial : store.partials()) {
+		if (partial.getLength() == 0) {
+			continue;
+		}
+		writer.pad(alignment);
+
+		ShardHeader shard{writer.position(), partial.getLength(), 0, partial.getLowestTime(), partial.getHighestTime()};
+		if constexpr (std::is_same_v<Type, dv::Frame>) {
+			for (const auto &frame : partial) {
+				const cv::Mat image = frame.image.isContinuous() ? frame.image : frame.image.clone();
+
+				FrameHeader header{};
+				header.timestamp = frame.timestamp;
+				header.exposure  = frame.exposure.count();
+				header.rows      = image.rows;
+				header.cols      = image.cols;
+				header.type      = image.type();
+				header.positionX = frame.positionX;
+				header.positionY = frame.positionY;
+				header.source    = static_cast<int8_t>(frame.source);
+				header.bytes     = image.total() * image.elemSize();
+				writer.write(&header, sizeof(header));
+				writer.write(image.data, header.bytes);
+				writer.pad(alignof(FrameHeader));
+			}
+		} else {
+			static_assert(std::is_trivially_copyable_v<Type>, "Only trivially copyable elements are stored raw");
+			writer.write(&*partial.begin(), partial.getLength() * sizeof(Type));
+		}
+
+		shard.bytes = writer.position() - shard.offset;
+		shards.push_back(shard);
+	}
+	return shards;
+}
+
+/**
+ * @brief Bounds checked access to a mapping, any type providing data() and size().
+ */
+template<class MappingType>
+[[nodiscard]] inline const char *checkedRange(const MappingType &file, const uint64_t offset, const uint64_t bytes) {
+	if (offset > file.size() || bytes > file.size() - offset) {
+		throw std::runtime_error("Corrupted cache file, data exceeds the file size");
+	}
+	return file.data() + offset;
+}
+
+template<class StorageType, class MappingType>
+[[nodiscard]] inline StorageType mapShards(
+	const std::shared_ptr<const MappingType> &file, const StreamHeader &stream, const ShardHeader *shards) {
+	using Type = typename StorageType::value_type;
+
+	StorageType store;
+	for (uint64_t i = 0; i < stream.shardCount; i++) {
+		const auto &shard    = shards[i];
+		const char *position = checkedRange(*file, shard.offset, shard.bytes);
+
+		if constexpr (std::is_same_v<Type, dv::Frame>) {
+			// Frames are copied, a cv::Mat handed out to the user must not outlive the mapping
+			auto packet = std::make_shared<typename StorageType::packet_type>();
+			packet->elements.reserve(shard.length);
+			const char *end = position + shard.bytes;
+			for (uint64_t j = 0; j < shard.length; j++) {
+				if (static_cast<size_t>(end - position) < sizeof(FrameHeader)) {
+					throw std::runtime_error("Corrupted cache file, truncated frame");
+				}
+				FrameHeader header;
+				std::memcpy(&header, position, sizeof(header));
+				position += sizeof(header);
+				if (header.bytes > static_cast<size_t>(end - position)) {
+					throw std::runtime_error("Corrupted cache file, truncated frame");
+				}
+
+				cv::Mat image(header.rows, header.cols, header.type);
+				if (image.total() * image.elemSize() != header.bytes) {
+					throw std::runtime_error("Corrupted cache file, frame size mismatch");
+				}
+				std::memcpy(image.data, position, header.bytes);
+				position += (header.bytes + alignof(FrameHeader) - 1) / alignof(FrameHeader) * alignof(FrameHeader);
+
+				packet->elements.emplace_back(header.timestamp, dv::Duration(header.exposure), header.positionX,
+					header.positionY, image, static_cast<dv::FrameSource>(header.source));
+			}
+			if (!packet->elements.empty()) {
+				store.add(StorageType(std::shared_ptr<const typename StorageType::packet_type>(std::move(packet))));
+			}
+		} else {
+			if (stream.elementSize != sizeof(Type) || shard.bytes != shard.length * sizeof(Type)
+				|| shard.offset % alignof(Type) != 0 || shard.lowestTime > shard.highestTime) {
+				throw std::runtime_error("Corrupted cache file, unexpected element layout");
+			}
+			store.addView(reinterpret_cast<const Type *>(position), shard.length, file, shard.lowestTime,
+				shard.highestTime);
+		}
+	}
+	return store;
+}
+
+} // namespace internal
+
+/**
+ * @brief Camera data restored from a cache file along with the resolutions it
+ * was recorded with.
+ */
+struct Contents {
+	MonoCameraData data;
+	std::optional<cv::Size> eventResolution;
+	std::optional<cv::Size> frameResolution;
+};
+
+namespace internal {
+
+/**
+ * @brief Lay out camera data through any writer providing write(), pad(), seek()
+ * and position().
+ */
+template<class WriterType>
+inline void serialize(WriterType &writer, const MonoCameraData &data, const std::optional<cv::Size> &eventResolution,
+	const std::optional<cv::Size> &frameResolution) {
+	const auto streamCount = static_cast<size_t>(std::distance(data.begin(), data.end()));
+
+	FileHeader header{};
+	std::memcpy(header.magic, magic, sizeof(header.magic));
+	header.version     = version;
+	header.streamCount = static_cast<uint32_t>(streamCount);
+	header.eventWidth  = eventResolution.has_value() ? eventResolution->width : 0;
+	header.eventHeight = eventResolution.has_value() ? eventResolution->height : 0;
+	header.frameWidth  = frameResolution.has_value() ? frameResolution->width : 0;
+	header.frameHeight = frameResolution.has_value() ? frameResolution->height : 0;
+	writer.write(&header, sizeof(header));
+
+	// Stream headers are written once the shard tables are placed
+	std::vector<StreamHeader> streams(streamCount);
+	writer.write(streams.data(), streams.size() * sizeof(StreamHeader));
+
+	std::vector<std::vector<ShardHeader>> tables;
+	size_t index = 0;
+	for (const auto &[key, value] : data) {
+		if (key.size() >= sizeof(StreamHeader::name)) {
+			throw std::invalid_argument("Stream name " + key + " is too long for the cache format");
+		}
+
+		auto &stream = streams[index++];
+		std::memcpy(stream.name, key.data(), key.size());
+		stream.kind = static_cast<uint32_t>(value.index());
+		tables.push_back(std::visit(
+			[&writer, &stream](const auto &store) {
+				stream.elementSize = sizeof(typename std::decay_t<decltype(store)>::value_type);
+				return writeShards(writer, store);
+			}, value));
+	}
+
+	writer.pad(alignof(ShardHeader));
+	for (size_t i = 0; i < streams.size(); i++) {
+		streams[i].shardCount       = tables[i].size();
+		streams[i].shardTableOffset = writer.position();
+		writer.write(tables[i].data(), tables[i].size() * sizeof(ShardHeader));
+	}
+
+	writer.seek(sizeof(header));
+	writer.write(streams.data(), streams.size() * sizeof(StreamHeader));
+}
+
+/**
+ * @brief Restore camera data from a mapping of the layout, events, IMUs and
+ * triggers reference the mapping and keep it alive.
+ */
+template<class MappingType>
+[[nodiscard]] inline Contents parse(const std::shared_ptr<const MappingType> &file, const std::string &source) {
+	FileHeader header{};
+	std::memcpy(&header, checkedRange(*file, 0, sizeof(header)), sizeof(header));
+	if (std::memcmp(header.magic, magic, sizeof(header.magic)) != 0) {
+		throw std::runtime_error(source + " is not a cache file");
+	}
+	if (header.version != version) {
+		throw std::runtime_error("Unsupported cache file version " + std::to_string(header.version));
+	}
+
+	Contents contents;
+	if (header.eventWidth > 0 && header.eventHeight > 0) {
+		contents.eventResolution = cv::Size(header.eventWidth, header.eventHeight);
+	}
+	if (header.frameWidth > 0 && header.frameHeight > 0) {
+		contents.frameResolution = cv::Size(header.frameWidth, header.frameHeight);
+	}
+
+	const auto *streams = reinterpret_cast<const StreamHeader *>(checkedRange(
+		*file, sizeof(header), static_cast<uint64_t>(header.streamCount) * sizeof(StreamHeader)));
+	for (uint32_t i = 0; i < header.streamCount; i++) {
+		const auto &stream = streams[i];
+		const auto *shards = reinterpret_cast<const ShardHeader *>(checkedRange(
+			*file, stream.shardTableOffset, stream.shardCount * sizeof(ShardHeader)));
+		const std::string name(stream.name, strnlen(stream.name, sizeof(stream.name)));
+
+		switch (stream.kind) {
+			case 0:
+				contents.data[name] = mapShards<EVTS>(file, stream, shards);
+				break;
+			case 1:
+				contents.data[name] = mapShards<FRME>(file, stream, shards);
+				break;
+			case 2:
+				contents.data[name] = mapShards<IMUS>(file, stream, shards);
+				break;
+			case 3:
+				contents.data[name] = mapShards<TRIG>(file, stream, shards);
+				break;
+			default:
+				throw std::runtime_error("Corrupted cache file, unknown stream type");
+		}
+	}
+
+	return contents;
+}
+
+} // namespace internal
+
+/**
+ * @brief Store camera data in the native cache format, shard by shard as they
+ * are laid out in memory.
+ */
+inline void save(const std::filesystem::path &path, const MonoCameraData &data,
+	const std::optional<cv::Size> &eventResolution = std::nullopt,
+	const std::optional<cv::Size> &frameResolution = std::nullopt) {
+	internal::Writer writer(path);
+	internal::serialize(writer, data, eventResolution, frameResolution);
+}
+
+/**
+ * @brief Open a cache file. The file is memory mapped and events, IMUs and
+ * triggers become shards referencing the mapping, so nothing is read or
+ * copied up front and pages are loaded when the data is first accessed. The
+ * mapping lives as long as any storage or slice refers to it.
+ */
+[[nodiscard]] inline Contents load(const std::filesystem::path &path) {
+	return internal::parse(std::make_shared<const MappedFile>(path), path.string());
+}
+
+} // namespace dv::toolkit::io::cache
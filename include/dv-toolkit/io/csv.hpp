@@ -0,0 +1,211 @@
+#pragma once
+
+#include "../core/core.hpp"
+#include "../core/base/concurrency.hpp"
+#include "./mmap.hpp"
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dv::toolkit::io::csv {
+
+namespace internal {
+
+inline const char *skipSpaces(const char *position, const char *end) noexcept {
+	while (position < end && (*position == ' ' || *position == '\t')) {
+		position++;
+	}
+	return position;
+}
+
+template<typename Type>
+inline const char *parseField(const char *position, const char *end, Type &value) {
+	position          = skipSpaces(position, end);
+	const auto result = std::from_chars(position, end, value);
+	if (result.ec != std::errc()) {
+		throw std::runtime_error("Malformed CSV event line");
+	}
+	return skipSpaces(result.ptr, end);
+}
+
+inline const char *expect(const char *position, const char *end, const char character) {
+	if (position >= end || *position != character) {
+		throw std::runtime_error("Malformed CSV event line");
+	}
+	return position + 1;
+}
+
+/**
+ * @brief Parse whole lines of `timestamp,x,y,polarity` within [begin, end),
+ * keeping the events `accept` returns true for.
+ */
+template<class Predicate>
+inline std::vector<dv::Event> parseEvents(const char *begin, const char *end, const Predicate &accept) {
+	std::vector<dv::Event> events;
+	// Lines of typical event dumps are around 25 bytes long
+	events.reserve(static_cast<size_t>(end - begin) / 24);
+
+	const char *position = begin;
+	while (position < end) {
+		if (*position == '\n' || *position == '\r') {
+			position++;
+			continue;
+		}
+
+		int64_t timestamp = 0;
+		int16_t x         = 0;
+		int16_t y         = 0;
+		uint8_t polarity  = 0;
+		position = parseField(position, end, timestamp);
+		position = expect(position, end, ',');
+		position = parseField(position, end, x);
+		position = expect(position, end, ',');
+		position = parseField(position, end, y);
+		position = expect(position, end, ',');
+		position = parseField(position, end, polarity);
+		if (position < end && *position == '\r') {
+			position++;
+		}
+		if (position < end && *position != '\n') {
+			throw std::runtime_error("Malformed CSV event line");
+		}
+
+		const dv::Event event(timestamp, x, y, polarity != 0);
+		if (accept(event)) {
+			events.push_back(event);
+		}
+	}
+
+	return events;
+}
+
+} // namespace internal
+
+/**
+ * @brief Settings of CSV parsing.
+ */
+struct ReadConfig {
+	/** Number of parsing threads */
+	size_t numThreads = std::thread::hardware_concurrency();
+	/** Bytes of text parsed by a single task, each becomes one storage shard */
+	size_t chunkSize = 8 * 1024 * 1024;
+};
+
+/**
+ * @brief Read events stored as `timestamp,x,y,polarity` lines, an optional
+ * header line is skipped. The file is memory mapped and split at line
+ * boundaries into chunks that are parsed concurrently with `std::from_chars`,
+ * every chunk becomes one shard of the returned storage.
+ *
+ * @param accept 	Called for every parsed event, rejected events are dropped
+ * 					before they are stored
+ */
+template<class Predicate>
+inline EventStorage readEvents(const std::filesystem::path &path, const ReadConfig &config, const Predicate &accept) {
+	const MappedFile file(path);
+	file.advise(MADV_SEQUENTIAL);
+
+	const char *begin = file.data();
+	const char *end   = file.data() + file.size();
+	if (begin == end) {
+		return EventStorage();
+	}
+
+	// A header starts with a non numeric character
+	if (*begin != '-' && (*begin < '0' || *begin > '9')) {
+		const auto *newline = static_cast<const char *>(std::memchr(begin, '\n', file.size()));
+		begin               = (newline == nullptr) ? end : newline + 1;
+	}
+
+	// Chunks end right after a newline, so no line is split between two tasks
+	std::vector<std::pair<const char *, const char *>> chunks;
+	const size_t chunkSize = std::max<size_t>(1, config.chunkSize);
+	while (begin < end) {
+		const char *chunkEnd = end;
+		if (static_cast<size_t>(end - begin) > chunkSize) {
+			const auto *newline = static_cast<const char *>(
+				std::memchr(begin + chunkSize, '\n', static_cast<size_t>(end - begin) - chunkSize));
+			chunkEnd = (newline == nullptr) ? end : newline + 1;
+		}
+		chunks.emplace_back(begin, chunkEnd);
+		begin = chunkEnd;
+	}
+
+	ThreadPool pool(std::min(config.numThreads, chunks.size()));
+	std::vector<std::future<std::vector<dv::Event>>> tasks;
+	tasks.reserve(chunks.size());
+	for (const auto &[chunkBegin, chunkEnd] : chunks) {
+		tasks.push_back(pool.submit([chunkBegin = chunkBegin, chunkEnd = chunkEnd, &accept] {
+			return internal::parseEvents(chunkBegin, chunkEnd, accept);
+		}));
+	}
+
+	EventStorage store;
+	for (auto &task : tasks) {
+		auto packet      = std::make_shared<EventPacket>();
+		packet->elements = task.get();
+		if (!packet->elements.empty()) {
+			store.add(EventStorage(std::shared_ptr<const EventPacket>(std::move(packet))));
+		}
+	}
+
+	return store;
+}
+
+inline EventStorage readEvents(const std::filesystem::path &path, const ReadConfig &config = ReadConfig()) {
+	return readEvents(path, config, [](const dv::Event &) {
+		return true;
+	});
+}
+
+/**
+ * @brief Write events as `timestamp,x,y,polarity` lines with a header line.
+ * Lines are formatted with `std::to_chars` into a large buffer that is
+ * flushed in blocks.
+ */
+inline void writeEvents(const std::filesystem::path &path, const EventStorage &store, const size_t bufferSize = 4 * 1024 * 1024) {
+	std::unique_ptr<FILE, decltype(&std::fclose)> file(std::fopen(path.c_str(), "wb"), &std::fclose);
+	if (file == nullptr) {
+		throw std::runtime_error("Failed to open " + path.string() + " for writing");
+	}
+
+	// Longest line: 20 digits timestamp, two 6 character coordinates, polarity and separators
+	constexpr size_t maxLineLength = 40;
+	std::vector<char> buffer(std::max(bufferSize, 2 * maxLineLength));
+	char *position = buffer.data();
+	char *limit    = buffer.data() + buffer.size() - maxLineLength;
+
+	const auto flush = [&] {
+		const auto length = static_cast<size_t>(position - buffer.data());
+		if (std::fwrite(buffer.data(), 1, length, file.get()) != length) {
+			throw std::runtime_error("Failed to write " + path.string());
+		}
+		position = buffer.data();
+	};
+
+	constexpr std::string_view header = "timestamp,x,y,polarity\n";
+	position = std::copy(header.begin(), header.end(), position);
+
+	char *bufferEnd = buffer.data() + buffer.size();
+	for (const auto &event : store) {
+		if (position > limit) {
+			flush();
+		}
+		position    = std::to_chars(position, bufferEnd, event.timestamp()).ptr;
+		*position++ = ',';
+		position    = std::to_chars(position, bufferEnd, event.x()).ptr;
+		*position++ = ',';
+		position    = std::to_chars(position, bufferEnd, event.y()).ptr;
+		*position++ = ',';
+		*position++ = event.polarity() ? '1' : '0';
+		*position++ = '\n';
+	}
+	flush();
+}
+
+} // namespace dv::toolkit::io::csv
@@ -0,0 +1,480 @@
+#pragma once
+
+#include "../core/core.hpp"
+#include "../core/base/concurrency.hpp"
+#include "./reader.hpp"
+#include <dv-processing/io/mono_camera_recording.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <tuple>
+
+namespace dv::toolkit::io {
+
+/**
+ * @brief Settings of a dataset reader.
+ */
+struct DatasetConfig {
+    /** Threads indexing recordings and loading samples */
+    size_t numThreads = std::thread::hardware_concurrency();
+    /** Samples held in memory, including those still being loaded */
+    size_t cacheCapacity = 64;
+    /** Scheduled samples loaded ahead of the one being consumed */
+    size_t prefetchDepth = 16;
+    /** Index file relative to the dataset directory, an empty path disables it */
+    fs::path indexFile = ".dvtk-index";
+    /** Look for recordings in subdirectories too */
+    bool recursive = true;
+};
+
+/**
+ * @brief Index entry of a single recording.
+ */
+struct RecordingInfo {
+    fs::path path;
+    uintmax_t fileSize = 0;
+    /** Modification time of the file, the entry is rebuilt when it changes */
+    int64_t modified  = 0;
+    int64_t startTime = 0;
+    int64_t endTime   = 0;
+    bool events       = false;
+    bool frames       = false;
+    bool imus         = false;
+    bool triggers     = false;
+    std::optional<cv::Size> eventResolution;
+    std::optional<cv::Size> frameResolution;
+
+    [[nodiscard]] int64_t duration() const noexcept {
+        return endTime - startTime;
+    }
+};
+
+/**
+ * @brief Time window [startTime, endTime) of a recording of the dataset.
+ */
+struct DatasetSample {
+    size_t recording  = 0;
+    int64_t startTime = 0;
+    int64_t endTime   = 0;
+
+    [[nodiscard]] bool operator<(const DatasetSample &other) const noexcept {
+        return std::tie(recording, startTime, endTime) < std::tie(other.recording, other.startTime, other.endTime);
+    }
+
+    [[nodiscard]] bool operator==(const DatasetSample &other) const noexcept {
+        return std::tie(recording, startTime, endTime) == std::tie(other.recording, other.startTime, other.endTime);
+    }
+};
+
+struct DatasetStatistics {
+    /** Samples found in the cache, loaded or in flight */
+    size_t hits{0};
+    /** Samples loaded on demand */
+    size_t misses{0};
+    /** Samples dropped from the cache to respect its capacity */
+    size_t evictions{0};
+};
+
+/**
+ * @brief Reader of a directory of aedat4 recordings serving time windows of
+ * any recording. The directory is indexed once, time ranges, sizes and stream
+ * availability are stored in a sidecar index file, and only new or modified
+ * recordings are opened again on the next start.
+ *
+ * Samples are loaded by a thread pool into a bounded cache evicting the least
+ * recently used sample. A schedule of samples can be consumed with next(),
+ * which keeps `prefetchDepth` samples loading ahead of the consumer.
+ */
+class DatasetReader {
+public:
+    using SampleData = std::shared_ptr<const MonoCameraData>;
+
+private:
+    struct CacheEntry {
+        std::shared_future<SampleData> data;
+        std::list<DatasetSample>::iterator usage;
+        /** Prefetched and not consumed yet, evicted only when nothing else is left */
+        bool pending;
+    };
+
+    fs::path mDirectory;
+    DatasetConfig mConfig;
+    std::vector<RecordingInfo> mRecordings;
+    /** Recordings that failed to open while indexing, with the reason */
+    std::vector<std::pair<fs::path, std::string>> mSkipped;
+
+    std::mutex mMutex;
+    std::map<DatasetSample, CacheEntry> mCache;
+    /** Cached samples, most recently used first */
+    std::list<DatasetSample> mUsage;
+    DatasetStatistics mStatistics;
+
+    std::vector<DatasetSample> mSchedule;
+    size_t mNext       = 0;
+    size_t mPrefetched = 0;
+
+    /** Set on destruction, pending loads are skipped */
+    std::atomic<bool> mClosing{false};
+    /** Declared last, workers are joined before the state they use is destroyed */
+    kit::ThreadPool mPool;
+
+    static int64_t _modification_time(const fs::path &path) {
+        return static_cast<int64_t>(fs::last_write_time(path).time_since_epoch().count());
+    }
+
+    static RecordingInfo _probe(const fs::path &path) {
+        dv::io::MonoCameraRecording recording(path);
+
+        RecordingInfo info;
+        info.path                       = path;
+        info.fileSize                   = fs::file_size(path);
+        info.modified                   = _modification_time(path);
+        const auto [startTime, endTime] = recording.getTimeRange();
+        info.startTime                  = startTime;
+        info.endTime                    = endTime;
+        info.events                     = recording.isEventStreamAvailable();
+        info.frames                     = recording.isFrameStreamAvailable();
+        info.imus                       = recording.isImuStreamAvailable();
+        info.triggers                   = recording.isTriggerStreamAvailable();
+        info.eventResolution            = recording.getEventResolution();
+        info.frameResolution            = recording.getFrameResolution();
+        return info;
+    }
+
+    /** One line per recording, the relative path comes last as it may contain spaces */
+    std::map<fs::path, RecordingInfo> _read_index() const {
+        std::map<fs::path, RecordingInfo> entries;
+        std::ifstream file(mDirectory / mConfig.indexFile);
+        std::string line;
+        if (!std::getline(file, line) || line != "# dv-toolkit dataset index 1") {
+            return entries;
+        }
+
+        while (std::getline(file, line)) {
+            std::istringstream stream(line);
+            RecordingInfo info;
+            int streams = 0;
+            cv::Size eventResolution;
+            cv::Size frameResolution;
+            stream >> info.fileSize >> info.modified >> info.startTime >> info.endTime >> streams >> eventResolution.width
+                >> eventResolution.height >> frameResolution.width >> frameResolution.height;
+
+            std::string relative;
+            if (!stream || !std::getline(stream >> std::ws, relative)) {
+                continue;
+            }
+
+            info.path     = mDirectory / relative;
+            info.events   = (streams & 0x1) != 0;
+            info.frames   = (streams & 0x2) != 0;
+            info.imus     = (streams & 0x4) != 0;
+            info.triggers = (streams & 0x8) != 0;
+            if (eventResolution.width > 0) {
+                info.eventResolution = eventResolution;
+            }
+            if (frameResolution.width > 0) {
+                info.frameResolution = frameResolution;
+            }
+            entries[info.path] = info;
+        }
+        return entries;
+    }
+
+    /** The index is replaced atomically, a read-only dataset simply stays unindexed */
+    void _write_index() const {
+        const fs::path path      = mDirectory / mConfig.indexFile;
+        const fs::path temporary = fs::path(path.string() + ".tmp");
+        {
+            std::ofstream file(temporary, std::ios::trunc);
+            if (!file) {
+                return;
+            }
+            file << "# dv-toolkit dataset index 1\n";
+            for (const auto &info : mRecordings) {
+                const int streams = (info.events ? 0x1 : 0) | (info.frames ? 0x2 : 0) | (info.imus ? 0x4 : 0)
+                                  | (info.triggers ? 0x8 : 0);
+                const auto eventResolution = info.eventResolution.value_or(cv::Size(0, 0));
+                const auto frameResolution = info.frameResolution.value_or(cv::Size(0, 0));
+                file << info.fileSize << ' ' << info.modified << ' ' << info.startTime << ' ' << info.endTime << ' '
+                     << streams << ' ' << eventResolution.width << ' ' << eventResolution.height << ' '
+                     << frameResolution.width << ' ' << frameResolution.height << ' '
+                     << fs::relative(info.path, mDirectory).string() << '\n';
+            }
+            if (!file) {
+                return;
+            }
+        }
+        std::error_code error;
+        fs::rename(temporary, path, error);
+    }
+
+    void _index() {
+        std::vector<fs::path> paths;
+        const auto collect = [&paths](const fs::directory_entry &entry) {
+            if (entry.is_regular_file() && entry.path().extension() == ".aedat4") {
+                paths.push_back(entry.path());
+            }
+        };
+        if (mConfig.recursive) {
+            for (const auto &entry : fs::recursive_directory_iterator(mDirectory)) {
+                collect(entry);
+            }
+        } else {
+            for (const auto &entry : fs::directory_iterator(mDirectory)) {
+                collect(entry);
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+
+        const auto indexed = mConfig.indexFile.empty() ? std::map<fs::path, RecordingInfo>() : _read_index();
+
+        // Recordings missing from the index or modified since are opened concurrently
+        std::vector<std::future<RecordingInfo>> probes(paths.size());
+        std::vector<std::optional<RecordingInfo>> known(paths.size());
+        size_t reused = 0;
+        for (size_t i = 0; i < paths.size(); i++) {
+            const auto entry = indexed.find(paths[i]);
+            if (entry != indexed.end() && entry->second.fileSize == fs::file_size(paths[i])
+                && entry->second.modified == _modification_time(paths[i])) {
+                known[i] = entry->second;
+                reused++;
+            } else {
+                probes[i] = mPool.submit([path = paths[i]] {
+                    return _probe(path);
+                });
+            }
+        }
+
+        // A recording that cannot be opened is skipped rather than failing the whole dataset,
+        // it stays out of the index and is probed again next time
+        bool changed = reused != indexed.size();
+        mRecordings.reserve(paths.size());
+        for (size_t i = 0; i < paths.size(); i++) {
+            if (known[i].has_value()) {
+                mRecordings.push_back(*known[i]);
+                continue;
+            }
+            try {
+                mRecordings.push_back(probes[i].get());
+                changed = true;
+            } catch (const std::exception &exception) {
+                mSkipped.emplace_back(paths[i], exception.what());
+            }
+        }
+
+        if (changed && !mConfig.indexFile.empty()) {
+            _write_index();
+        }
+    }
+
+    /** Find or start loading a sample, the mutex must be held */
+    std::shared_future<SampleData> _request(const DatasetSample &sample, const bool consumed) {
+        if (sample.recording >= mRecordings.size()) {
+            throw std::out_of_range("Sample refers to a recording outside of the dataset");
+        }
+
+        if (const auto entry = mCache.find(sample); entry != mCache.end()) {
+            mUsage.splice(mUsage.begin(), mUsage, entry->second.usage);
+            if (consumed) {
+                entry->second.pending = false;
+                mStatistics.hits++;
+            }
+            return entry->second.data;
+        }
+        if (consumed) {
+            mStatistics.misses++;
+        }
+
+        std::shared_future<SampleData> data = mPool.submit([this, sample]() -> SampleData {
+            if (mClosing) {
+                return nullptr;
+            }
+            MonoCameraReader reader(mRecordings[sample.recording].path);
+            return std::make_shared<const MonoCameraData>(reader.loadRange(sample.startTime, sample.endTime));
+        });
+
+        mUsage.push_front(sample);
+        mCache.emplace(sample, CacheEntry{data, mUsage.begin(), !consumed});
+        while (mCache.size() > mConfig.cacheCapacity) {
+            // Least recently used first, samples waiting to be consumed last
+            auto victim = std::prev(mUsage.end());
+            while (victim != mUsage.begin() && mCache.at(*victim).pending) {
+                victim--;
+            }
+            if (*victim == sample || mCache.at(*victim).pending) {
+                victim = std::prev(mUsage.end());
+            }
+            mCache.erase(*victim);
+            mUsage.erase(victim);
+            mStatistics.evictions++;
+        }
+        return data;
+    }
+
+    /** Keep the scheduled samples following the consumer in flight */
+    void _top_up() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPrefetched = std::max(mPrefetched, mNext);
+        while (mPrefetched < mSchedule.size() && mPrefetched < mNext + mConfig.prefetchDepth) {
+            _request(mSchedule[mPrefetched++], false);
+        }
+    }
+
+public:
+    /**
+     * @param directory Directory holding the aedat4 recordings
+     * @param config 	Cache, prefetch and indexing settings
+     */
+    explicit DatasetReader(const fs::path &directory, const DatasetConfig &config = DatasetConfig()) :
+        mDirectory(directory),
+        mConfig(config),
+        mPool(config.numThreads) {
+        if (!fs::is_directory(directory)) {
+            throw std::invalid_argument("Dataset directory " + directory.string() + " does not exist");
+        }
+        if (mConfig.cacheCapacity == 0) {
+            throw std::invalid_argument("Cache capacity must be greater than zero");
+        }
+        // Prefetched samples must not evict each other before they are consumed
+        mConfig.prefetchDepth = std::min(mConfig.prefetchDepth, mConfig.cacheCapacity - 1);
+        _index();
+    }
+
+    DatasetReader(const DatasetReader &other)            = delete;
+    DatasetReader &operator=(const DatasetReader &other) = delete;
+
+    ~DatasetReader() {
+        mClosing = true;
+    }
+
+    [[nodiscard]] const std::vector<RecordingInfo> &recordings() const noexcept {
+        return mRecordings;
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return mRecordings.size();
+    }
+
+    /**
+     * @brief Recordings left out of the dataset because they could not be opened,
+     * each with the error raised while reading it.
+     */
+    [[nodiscard]] const std::vector<std::pair<fs::path, std::string>> &skipped() const noexcept {
+        return mSkipped;
+    }
+
+    /**
+     * @brief Draw random time windows of `duration`. Recordings are drawn with a
+     * probability proportional to their duration and the window start uniformly
+     * within the recording, windows of recordings shorter than `duration` cover
+     * the whole recording.
+     */
+    [[nodiscard]] std::vector<DatasetSample> randomSamples(const size_t count, const dv::Duration duration,
+        const uint64_t seed = std::random_device()()) const {
+        if (duration.count() <= 0) {
+            throw std::invalid_argument("Sample duration must be greater than zero");
+        }
+
+        std::vector<double> weights;
+        weights.reserve(mRecordings.size());
+        for (const auto &info : mRecordings) {
+            weights.push_back(static_cast<double>(std::max<int64_t>(info.duration(), 0)));
+        }
+        if (std::all_of(weights.begin(), weights.end(), [](const double weight) {
+                return weight <= 0.0;
+            })) {
+            throw std::runtime_error("Dataset holds no recording with a positive duration");
+        }
+
+        std::mt19937_64 generator(seed);
+        std::discrete_distribution<size_t> recording(weights.begin(), weights.end());
+        std::vector<DatasetSample> samples;
+        samples.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            const size_t index = recording(generator);
+            const auto &info   = mRecordings[index];
+            const int64_t last = std::max(info.startTime, info.endTime + 1 - duration.count());
+            const int64_t start = std::uniform_int_distribution<int64_t>(info.startTime, last)(generator);
+            samples.push_back(DatasetSample{index, start, std::min(start + duration.count(), info.endTime + 1)});
+        }
+        return samples;
+    }
+
+    /**
+     * @brief Start loading a sample in the background.
+     */
+    void prefetch(const DatasetSample &sample) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        _request(sample, false);
+    }
+
+    /**
+     * @brief Data of a sample, from the cache when it was loaded or prefetched
+     * before, otherwise loaded now.
+     */
+    [[nodiscard]] SampleData load(const DatasetSample &sample) {
+        std::shared_future<SampleData> data;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            data = _request(sample, true);
+        }
+
+        try {
+            return data.get();
+        } catch (...) {
+            // Failed loads are not cached, a later request tries again
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (const auto entry = mCache.find(sample); entry != mCache.end()) {
+                mUsage.erase(entry->second.usage);
+                mCache.erase(entry);
+            }
+            throw;
+        }
+    }
+
+    /**
+     * @brief Set the samples consumed by next(), loading of the first ones starts
+     * right away.
+     */
+    void schedule(std::vector<DatasetSample> samples) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mSchedule   = std::move(samples);
+            mNext       = 0;
+            mPrefetched = 0;
+        }
+        _top_up();
+    }
+
+    /**
+     * @brief Next sample of the schedule, the following ones are loaded meanwhile.
+     *
+     * @return The sample and its data, or std::nullopt once the schedule is consumed.
+     */
+    [[nodiscard]] std::optional<std::pair<DatasetSample, SampleData>> next() {
+        DatasetSample sample;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mNext >= mSchedule.size()) {
+                return std::nullopt;
+            }
+            sample = mSchedule[mNext++];
+        }
+        _top_up();
+        return std::make_pair(sample, load(sample));
+    }
+
+    [[nodiscard]] DatasetStatistics statistics() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mStatistics;
+    }
+};
+
+} // namespace dv::toolkit::io
@@ -0,0 +1,397 @@
+#pragma once
+
+#include "../core/core.hpp"
+#include "./mmap.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dv::toolkit::io::evt {
+
+/**
+ * @brief Encodings of Prophesee raw recordings.
+ */
+enum class Format {
+	EVT2,
+	EVT3
+};
+
+namespace internal {
+
+template<typename WordType>
+[[nodiscard]] inline WordType load(const char *position) noexcept {
+	// Data following the text header is not necessarily aligned
+	WordType word;
+	std::memcpy(&word, position, sizeof(WordType));
+	return word;
+}
+
+[[nodiscard]] inline dv::Trigger makeTrigger(const int64_t timestamp, const bool value) {
+	return dv::Trigger(timestamp,
+		value ? dv::TriggerType::EXTERNAL_SIGNAL_RISING_EDGE : dv::TriggerType::EXTERNAL_SIGNAL_FALLING_EDGE);
+}
+
+} // namespace internal
+
+/**
+ * @brief Decoder of the EVT 2.0 encoding, 32 bit words carrying one event
+ * each. The decoder keeps its state between calls, so a stream can be fed in
+ * chunks of any number of whole words.
+ */
+class Evt2Decoder {
+private:
+	/** Time accumulated by wrap-arounds of the 34 bit sensor clock */
+	int64_t mTimeBase  = 0;
+	int64_t mTimeHigh  = 0;
+	int64_t mTimestamp = 0;
+	bool mTimeKnown    = false;
+
+public:
+	static constexpr size_t wordSize = sizeof(uint32_t);
+
+	/**
+	 * @brief Decode `count` words. Timestamps never decrease, events preceding
+	 * the first time reference of the stream are skipped.
+	 */
+	void decode(const char *data, const size_t count, std::vector<dv::Event> &events, std::vector<dv::Trigger> &triggers) {
+		for (size_t i = 0; i < count; i++) {
+			const auto word = internal::load<uint32_t>(data + i * wordSize);
+			switch (word >> 28) {
+				case 0x0:
+				case 0x1: {
+					if (!mTimeKnown) {
+						break;
+					}
+					mTimestamp = std::max(mTimestamp, mTimeBase + ((mTimeHigh << 6) | ((word >> 22) & 0x3F)));
+					events.emplace_back(mTimestamp, static_cast<int16_t>((word >> 11) & 0x7FF),
+						static_cast<int16_t>(word & 0x7FF), (word >> 28) == 0x1);
+					break;
+				}
+				case 0x8: {
+					const int64_t timeHigh = word & 0x0FFFFFFF;
+					if (mTimeKnown && timeHigh < mTimeHigh) {
+						mTimeBase += int64_t(1) << 34;
+					}
+					mTimeHigh  = timeHigh;
+					mTimeKnown = true;
+					break;
+				}
+				case 0xA: {
+					if (!mTimeKnown) {
+						break;
+					}
+					mTimestamp = std::max(mTimestamp, mTimeBase + ((mTimeHigh << 6) | ((word >> 22) & 0x3F)));
+					triggers.push_back(internal::makeTrigger(mTimestamp, (word & 0x1) != 0));
+					break;
+				}
+				default:
+					break;
+			}
+		}
+	}
+};
+
+/**
+ * @brief Decoder of the EVT 3.0 encoding, 16 bit words setting the row, the
+ * time or a base column, followed by single events or bit masks of up to 12
+ * events on consecutive columns. Masks are decoded one set bit at a time with
+ * `std::countr_zero`, so the cost is proportional to the number of events.
+ */
+class Evt3Decoder {
+private:
+	/** Time accumulated by wrap-arounds of the 24 bit sensor clock */
+	int64_t mTimeBase  = 0;
+	int64_t mTimeHigh  = 0;
+	int64_t mTimeLow   = 0;
+	int64_t mTimestamp = 0;
+	bool mTimeKnown    = false;
+	int16_t mY         = 0;
+	int16_t mBaseX     = 0;
+	bool mPolarity     = false;
+
+	void updateTime() noexcept {
+		mTimestamp = std::max(mTimestamp, mTimeBase + ((mTimeHigh << 12) | mTimeLow));
+	}
+
+	void decodeVector(uint32_t mask, const int16_t width, std::vector<dv::Event> &events) {
+		if (mTimeKnown) {
+			while (mask != 0) {
+				const int bit = std::countr_zero(mask);
+				events.emplace_back(mTimestamp, static_cast<int16_t>(mBaseX + bit), mY, mPolarity);
+				mask &= mask - 1;
+			}
+		}
+		mBaseX = static_cast<int16_t>(mBaseX + width);
+	}
+
+public:
+	static constexpr size_t wordSize = sizeof(uint16_t);
+
+	/**
+	 * @brief Decode `count` words. Timestamps never decrease, events preceding
+	 * the first time reference of the stream are skipped.
+	 */
+	void decode(const char *data, const size_t count, std::vector<dv::Event> &events, std::vector<dv::Trigger> &triggers) {
+		for (size_t i = 0; i < count; i++) {
+			const auto word = internal::load<uint16_t>(data + i * wordSize);
+			switch (word >> 12) {
+				case 0x0:
+					mY = static_cast<int16_t>(word & 0x7FF);
+					break;
+				case 0x2:
+					if (mTimeKnown) {
+						events.emplace_back(mTimestamp, static_cast<int16_t>(word & 0x7FF), mY, ((word >> 11) & 0x1) != 0);
+					}
+					break;
+				case 0x3:
+					mBaseX    = static_cast<int16_t>(word & 0x7FF);
+					mPolarity = ((word >> 11) & 0x1) != 0;
+					break;
+				case 0x4:
+					decodeVector(word & 0xFFF, 12, events);
+					break;
+				case 0x5:
+					decodeVector(word & 0xFF, 8, events);
+					break;
+				case 0x6:
+					mTimeLow = word & 0xFFF;
+					updateTime();
+					break;
+				case 0x8: {
+					const int64_t timeHigh = word & 0xFFF;
+					// A new time high always precedes the matching time low
+					mTimeLow = 0;
+					if (mTimeKnown && timeHigh < mTimeHigh) {
+						mTimeBase += int64_t(1) << 24;
+					}
+					mTimeHigh  = timeHigh;
+					mTimeKnown = true;
+					updateTime();
+					break;
+				}
+				case 0xA:
+					if (mTimeKnown) {
+						triggers.push_back(internal::makeTrigger(mTimestamp, (word & 0x1) != 0));
+					}
+					break;
+				default:
+					break;
+			}
+		}
+	}
+};
+
+/**
+ * @brief Text header of a raw recording, lines starting with `%` and usually
+ * closed by a `% end` line.
+ */
+struct RawHeader {
+	Format format = Format::EVT3;
+	std::optional<cv::Size> resolution;
+	/** Offset of the first data word in the file */
+	size_t dataOffset = 0;
+
+	/**
+	 * @brief Lines of the header, up to the closing `% end` line. Without it,
+	 * the header ends at the first line that is not printable text starting
+	 * with `% `, so data starting with the byte of `%` is not taken for a header line.
+	 */
+	[[nodiscard]] static std::vector<std::string_view> lines(std::string_view file, size_t &dataOffset) {
+		std::vector<std::string_view> lines;
+		size_t position = 0;
+		while (position < file.size() && file[position] == '%') {
+			const size_t end = file.find('\n', position);
+			if (end == std::string_view::npos) {
+				break;
+			}
+			const auto line = file.substr(position, end - position);
+			position        = end + 1;
+			if (line.rfind("% end", 0) == 0) {
+				dataOffset = position;
+				return lines;
+			}
+			lines.push_back(line);
+		}
+
+		const auto isHeaderLine = [](std::string_view line) {
+			const bool text = std::all_of(line.begin(), line.end(), [](const char character) {
+				return (character >= 0x20 && character < 0x7F) || character == '\t' || character == '\r';
+			});
+			return text && (line.size() == 1 || line[1] == ' ' || line[1] == '\r');
+		};
+		lines.erase(std::find_if_not(lines.begin(), lines.end(), isHeaderLine), lines.end());
+
+		dataOffset = 0;
+		for (const auto line : lines) {
+			dataOffset += line.size() + 1;
+		}
+		return lines;
+	}
+
+	[[nodiscard]] static RawHeader parse(std::string_view file) {
+		RawHeader header;
+		std::optional<Format> format;
+
+		const auto field = [](std::string_view text, std::string_view key) -> std::optional<int> {
+			const auto position = text.find(key);
+			if (position == std::string_view::npos) {
+				return std::nullopt;
+			}
+			return std::atoi(std::string(text.substr(position + key.size())).c_str());
+		};
+
+		for (const auto line : lines(file, header.dataOffset)) {
+			if (line.rfind("% format ", 0) == 0) {
+				// e.g. "% format EVT3;height=720;width=1280"
+				auto name = line.substr(9);
+				name      = name.substr(0, name.find_first_of(";\r"));
+				if (name == "EVT3") {
+					format = Format::EVT3;
+				} else if (name == "EVT2") {
+					format = Format::EVT2;
+				} else {
+					throw std::runtime_error("Unsupported raw event format " + std::string(name));
+				}
+				const auto width  = field(line, "width=");
+				const auto height = field(line, "height=");
+				if (width.has_value() && height.has_value()) {
+					header.resolution = cv::Size(*width, *height);
+				}
+			} else if (line.rfind("% evt ", 0) == 0 && !format.has_value()) {
+				const auto version = line.substr(6);
+				if (version.rfind("3.0", 0) == 0) {
+					format = Format::EVT3;
+				} else if (version.rfind("2.0", 0) == 0) {
+					format = Format::EVT2;
+				} else {
+					throw std::runtime_error("Unsupported raw event format " + std::string(version));
+				}
+			} else if (line.rfind("% geometry ", 0) == 0 && !header.resolution.has_value()) {
+				// e.g. "% geometry 1280x720"
+				const auto geometry  = std::string(line.substr(11));
+				const auto separator = geometry.find('x');
+				if (separator != std::string::npos) {
+					header.resolution = cv::Size(std::atoi(geometry.c_str()), std::atoi(geometry.c_str() + separator + 1));
+				}
+			}
+		}
+
+		if (!format.has_value()) {
+			throw std::runtime_error("Raw recording does not declare its event format");
+		}
+		if (header.resolution.has_value() && (header.resolution->width <= 0 || header.resolution->height <= 0)) {
+			throw std::runtime_error("Raw recording declares an invalid resolution");
+		}
+		header.format = *format;
+		return header;
+	}
+};
+
+/**
+ * @brief Reader of Prophesee raw recordings in EVT 2.0 or EVT 3.0 encoding. The
+ * file is memory mapped and decoded in chunks, every chunk becomes one shard
+ * of events, so a recording can be streamed with bounded memory. When the
+ * caller drops a chunk before asking for the next one, its event buffer is
+ * reused, so streaming does not fault in fresh memory for every chunk.
+ * Timestamps are those of the sensor clock, in microseconds.
+ */
+class RawReader {
+private:
+	MappedFile mFile;
+	RawHeader mHeader;
+	size_t mPosition = 0;
+	size_t mChunkSize;
+	/** Density of the previous chunk, EVT 3.0 vectors carry up to 12 events per word */
+	double mEventsPerWord = 1.0;
+	/** Events of the previous chunk, reused once no storage refers to them anymore */
+	std::shared_ptr<EventPacket> mPacket;
+	Evt2Decoder mEvt2;
+	Evt3Decoder mEvt3;
+
+	[[nodiscard]] size_t wordSize() const noexcept {
+		return (mHeader.format == Format::EVT2) ? Evt2Decoder::wordSize : Evt3Decoder::wordSize;
+	}
+
+public:
+	/**
+	 * @param path 		Path of the recording
+	 * @param chunkSize Bytes of the file decoded by a single call to next()
+	 */
+	explicit RawReader(const std::filesystem::path &path, const size_t chunkSize = 1024 * 1024) :
+		mFile(path),
+		mHeader(RawHeader::parse(mFile.view())),
+		mPosition(mHeader.dataOffset),
+		mChunkSize(chunkSize) {
+		mFile.advise(MADV_SEQUENTIAL);
+		const size_t size = wordSize();
+		mChunkSize        = std::max(size, mChunkSize / size * size);
+	}
+
+	/**
+	 * @brief Decode the next chunk of the recording.
+	 *
+	 * @return Events and triggers of the chunk, or std::nullopt at the end of the file.
+	 */
+	[[nodiscard]] std::optional<MonoCameraData> next() {
+		const size_t size  = wordSize();
+		const size_t words = std::min(mChunkSize, mFile.size() - mPosition) / size;
+		if (words == 0) {
+			return std::nullopt;
+		}
+
+		if (mPacket == nullptr || mPacket.use_count() > 1) {
+			mPacket = std::make_shared<EventPacket>();
+		} else {
+			mPacket->elements.clear();
+		}
+
+		auto &events = mPacket->elements;
+		std::vector<dv::Trigger> triggers;
+		// Reserving from the density of the previous chunk avoids copying the
+		// events while the vector grows
+		events.reserve(static_cast<size_t>(static_cast<double>(words) * mEventsPerWord * 1.1) + 16);
+		if (mHeader.format == Format::EVT2) {
+			mEvt2.decode(mFile.data() + mPosition, words, events, triggers);
+		} else {
+			mEvt3.decode(mFile.data() + mPosition, words, events, triggers);
+		}
+		mPosition += words * size;
+		mEventsPerWord = static_cast<double>(events.size()) / static_cast<double>(words);
+
+		MonoCameraData chunk;
+		if (!events.empty()) {
+			chunk["events"] = EventStorage(std::shared_ptr<const EventPacket>(mPacket));
+		}
+		if (!triggers.empty()) {
+			chunk["triggers"] = TriggerStorage(TriggerPacket(triggers));
+		}
+		return chunk;
+	}
+
+	/**
+	 * @brief Decode the rest of the recording.
+	 */
+	[[nodiscard]] MonoCameraData readAll() {
+		MonoCameraData data;
+		while (const auto chunk = next()) {
+			data.add(*chunk);
+		}
+		return data;
+	}
+
+	[[nodiscard]] Format getFormat() const noexcept {
+		return mHeader.format;
+	}
+
+	[[nodiscard]] std::optional<cv::Size> getResolution() const noexcept {
+		return mHeader.resolution;
+	}
+};
+
+} // namespace dv::toolkit::io::evt
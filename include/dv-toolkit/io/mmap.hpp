@@ -0,0 +1,108 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace dv::toolkit::io {
+
+/**
+ * @brief Read-only memory mapping of a whole file. Pages are loaded on demand
+ * by the operating system, the mapping is released on destruction.
+ */
+class MappedFile {
+private:
+	const char *mData = nullptr;
+	size_t mSize      = 0;
+
+	void release() noexcept {
+		if (mData != nullptr) {
+			munmap(const_cast<char *>(mData), mSize);
+		}
+		mData = nullptr;
+		mSize = 0;
+	}
+
+public:
+	MappedFile() = default;
+
+	explicit MappedFile(const std::filesystem::path &path) {
+		const int descriptor = ::open(path.c_str(), O_RDONLY);
+		if (descriptor < 0) {
+			throw std::runtime_error("Failed to open " + path.string() + ": " + std::strerror(errno));
+		}
+
+		struct stat status {};
+		if (fstat(descriptor, &status) != 0) {
+			::close(descriptor);
+			throw std::runtime_error("Failed to stat " + path.string() + ": " + std::strerror(errno));
+		}
+
+		mSize = static_cast<size_t>(status.st_size);
+		if (mSize > 0) {
+			void *address = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, descriptor, 0);
+			if (address == MAP_FAILED) {
+				::close(descriptor);
+				throw std::runtime_error("Failed to map " + path.string() + ": " + std::strerror(errno));
+			}
+			mData = static_cast<const char *>(address);
+		}
+
+		// The mapping stays valid after the descriptor is closed
+		::close(descriptor);
+	}
+
+	MappedFile(const MappedFile &other)            = delete;
+	MappedFile &operator=(const MappedFile &other) = delete;
+
+	MappedFile(MappedFile &&other) noexcept : mData(other.mData), mSize(other.mSize) {
+		other.mData = nullptr;
+		other.mSize = 0;
+	}
+
+	MappedFile &operator=(MappedFile &&other) noexcept {
+		if (this != &other) {
+			release();
+			mData       = other.mData;
+			mSize       = other.mSize;
+			other.mData = nullptr;
+			other.mSize = 0;
+		}
+		return *this;
+	}
+
+	~MappedFile() {
+		release();
+	}
+
+	/**
+	 * @brief Hint the expected access pattern to the operating system.
+	 */
+	void advise(const int advice) const noexcept {
+		if (mData != nullptr) {
+			madvise(const_cast<char *>(mData), mSize, advice);
+		}
+	}
+
+	[[nodiscard]] const char *data() const noexcept {
+		return mData;
+	}
+
+	[[nodiscard]] size_t size() const noexcept {
+		return mSize;
+	}
+
+	[[nodiscard]] std::string_view view() const noexcept {
+		return std::string_view(mData, mSize);
+	}
+};
+
+} // namespace dv::toolkit::io
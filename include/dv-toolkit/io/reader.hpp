@@ -1,5 +1,17 @@
+#pragma once
+
 #include "../core/core.hpp"
+#include "../core/base/concurrency.hpp"
+#include "./cache.hpp"
+#include "./csv.hpp"
+#include "./evt.hpp"
 #include <dv-processing/io/mono_camera_recording.hpp>
+#include <dv-processing/io/read_only_file.hpp>
+
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
 
 
 namespace fs = std::filesystem;
@@ -7,46 +19,398 @@ namespace kit = dv::toolkit;
 
 namespace dv::toolkit::io {
 
+/**
+ * @brief Settings of parallel loading.
+ */
+struct ParallelReadConfig {
+    /** Number of decoding threads */
+    size_t numThreads = std::thread::hardware_concurrency();
+    /** Number of segments decoded ahead of the one being appended */
+    size_t prefetchDepth = 2 * std::thread::hardware_concurrency();
+    /** Minimum time range decoded by a single task, segments end at event packet boundaries */
+    dv::Duration segmentDuration = dv::Duration(1000000);
+};
+
+/**
+ * @brief Selection applied while a recording is decoded. Streams that are not
+ * selected are not decoded, filtered events are never copied into storages.
+ */
+struct ReadOptions {
+    /** Streams to load */
+    bool events   = true;
+    bool frames   = true;
+    bool imus     = true;
+    bool triggers = true;
+    /** Events outside of the region are dropped */
+    std::optional<cv::Rect> roi;
+    /** Keep only events of the given polarity */
+    std::optional<bool> polarity;
+    /** Time range [startTime, endTime) of all streams */
+    int64_t startTime = std::numeric_limits<int64_t>::min();
+    int64_t endTime   = std::numeric_limits<int64_t>::max();
+
+    [[nodiscard]] bool filtersEvents() const noexcept {
+        return roi.has_value() || polarity.has_value();
+    }
+
+    [[nodiscard]] bool limitsTime() const noexcept {
+        return startTime != std::numeric_limits<int64_t>::min() || endTime != std::numeric_limits<int64_t>::max();
+    }
+
+    [[nodiscard]] bool accepts(const dv::Event &event) const noexcept {
+        return (!polarity.has_value() || event.polarity() == *polarity)
+            && (!roi.has_value() || roi->contains(cv::Point(event.x(), event.y())));
+    }
+
+    /**
+     * @brief Events of `batch` passing the region and polarity filters.
+     */
+    template<class EventRange>
+    [[nodiscard]] std::vector<dv::Event> selectEvents(const EventRange &batch) const {
+        std::vector<dv::Event> selected;
+        for (const auto &event : batch) {
+            if (accepts(event)) {
+                selected.push_back(event);
+            }
+        }
+        return selected;
+    }
+};
+
 class MonoCameraReader {
 private:
+    /** Events of a decoded batch as a storage, filtered when the options ask for it */
+    template<class EventBatch>
+    [[nodiscard]] kit::EventStorage _select_events(const EventBatch &events) const {
+        if (mOptions.filtersEvents()) {
+            return kit::EventStorage(kit::EventPacket(mOptions.selectEvents(events)));
+        }
+        return kit::EventStorage(kit::EventPacket(events.toPacket().elements));
+    }
+
+    /**
+     * @brief Apply the options to data loaded by a backend which cannot filter while
+     * decoding, i.e. mapped caches and decoded raw chunks. Unselected streams are
+     * dropped and time slices share their shards.
+     */
+    [[nodiscard]] MonoCameraData _select(const MonoCameraData &data) const {
+        MonoCameraData selected;
+        for (const auto &[key, value] : data) {
+            const bool keep = std::visit(
+                [this](const auto &store) {
+                    using Type = std::decay_t<decltype(store)>;
+                    if constexpr (std::is_same_v<Type, EVTS>) {
+                        return mOptions.events;
+                    } else if constexpr (std::is_same_v<Type, FRME>) {
+                        return mOptions.frames;
+                    } else if constexpr (std::is_same_v<Type, IMUS>) {
+                        return mOptions.imus;
+                    } else {
+                        return mOptions.triggers;
+                    }
+                }, value);
+            if (!keep) {
+                continue;
+            }
+
+            selected[key] = std::visit(
+                [this](const auto &store) {
+                    using Type = std::decay_t<decltype(store)>;
+                    Type sliced = (mOptions.limitsTime() && !store.isEmpty())
+                                    ? store.sliceTime(mOptions.startTime, mOptions.endTime)
+                                    : store;
+                    if constexpr (std::is_same_v<Type, EVTS>) {
+                        if (mOptions.filtersEvents() && !sliced.isEmpty()) {
+                            return UnifiedType(kit::EventStorage(kit::EventPacket(mOptions.selectEvents(sliced))));
+                        }
+                    }
+                    return UnifiedType(std::move(sliced));
+                }, value);
+        }
+        return selected;
+    }
+
     MonoCameraData _load_from_aedat4() {
+        // A bounded time range is read through the packet time index instead
+        if (mOptions.limitsTime()) {
+            const auto [startTime, endTime] = _recording().getTimeRange();
+            return _read_time_range(_recording(), startTime, endTime + 1);
+        }
+
         dv::toolkit::MonoCameraData data;
 
-        // The isRunning() method of a dv::io::MonoCameraRecording returns false 
-        // if any data-stream reaches End-of-file. Thus, data readout stops after 
-        // any of the available data streams is complete.
-        dv::io::MonoCameraRecording eventReader(mFilePath);
-        while (eventReader.isRunning()) {
-            if (eventReader.isEventStreamAvailable()) {
-                if (const auto events = eventReader.getNextEventBatch(); events.has_value()) {
-                    const auto packet = kit::EventPacket(events->toPacket().elements);
-                    data.add("events", kit::EventStorage(packet));
+        // A single recording instance serves all streams, each stream keeps its own
+        // sequential read position, so every packet is decoded exactly once. Streams 
+        // are drained independently, the end of one does not stop the others.
+        auto &reader = _recording();
+        reader.resetSequentialRead();
+
+        if (mOptions.events && reader.isEventStreamAvailable()) {
+            auto &store = std::get<EVTS>(data["events"]);
+            while (const auto events = reader.getNextEventBatch()) {
+                if (!events->isEmpty()) {
+                    auto selected = _select_events(*events);
+                    if (!selected.isEmpty()) {
+                        store.add(selected);
+                    }
                 }
             }
         }
 
-        dv::io::MonoCameraRecording frameReader(mFilePath);
-        while (frameReader.isRunning()) {
-            if (frameReader.isFrameStreamAvailable()) {
-                if (const auto frame = frameReader.getNextFrame(); frame.has_value()) {
-                    const auto packet = kit::FramePacket(std::vector<dv::Frame>{*frame});
-                    data.add("frames", kit::FrameStorage(packet));
+        if (mOptions.frames && reader.isFrameStreamAvailable()) {
+            std::vector<dv::Frame> frames;
+            while (const auto frame = reader.getNextFrame()) {
+                frames.push_back(*frame);
+            }
+            if (!frames.empty()) {
+                data.add("frames", kit::FrameStorage(kit::FramePacket(frames)));
+            }
+        }
+
+        if (mOptions.imus && reader.isImuStreamAvailable()) {
+            auto &store = std::get<IMUS>(data["imus"]);
+            while (const auto imus = reader.getNextImuBatch()) {
+                if (!imus->empty()) {
+                    store.add(kit::IMUStorage(kit::IMUPacket(*imus)));
                 }
             }
         }
 
-        dv::io::MonoCameraRecording imuReader(mFilePath);
-        while (imuReader.isRunning()) {
-            if (imuReader.isImuStreamAvailable()) {
-                if (const auto imus = imuReader.getNextImuBatch(); imus.has_value()) {
-                    const auto packet = toolkit::IMUPacket(*imus);
-                    data.add("imus", kit::IMUStorage(packet));
+        if (mOptions.triggers && reader.isTriggerStreamAvailable()) {
+            auto &store = std::get<TRIG>(data["triggers"]);
+            while (const auto triggers = reader.getNextTriggerBatch()) {
+                if (!triggers->empty()) {
+                    store.add(kit::TriggerStorage(kit::TriggerPacket(*triggers)));
+                }
+            }
+        }
+
+        return data;
+    }
+
+    /**
+     * @brief Read the selected streams within [startTime, endTime) and the time range of
+     * the options using the time index of the recording, only the packets overlapping
+     * the range are decoded.
+     */
+    MonoCameraData _read_time_range(dv::io::MonoCameraRecording &reader, int64_t startTime, int64_t endTime) const {
+        dv::toolkit::MonoCameraData data;
+        startTime = std::max(startTime, mOptions.startTime);
+        endTime   = std::min(endTime, mOptions.endTime);
+        if (endTime <= startTime) {
+            return data;
+        }
+
+        if (mOptions.events && reader.isEventStreamAvailable()) {
+            if (const auto events = reader.getEventsTimeRange(startTime, endTime); events.has_value() && !events->isEmpty()) {
+                auto selected = _select_events(*events);
+                if (!selected.isEmpty()) {
+                    data.add("events", selected);
                 }
             }
         }
-        
-        mEventResolution = eventReader.getEventResolution();
-        mFrameResolution = frameReader.getFrameResolution();
+        if (mOptions.frames && reader.isFrameStreamAvailable()) {
+            if (const auto frames = reader.getFramesTimeRange(startTime, endTime); frames.has_value() && !frames->empty()) {
+                data.add("frames", kit::FrameStorage(kit::FramePacket(*frames)));
+            }
+        }
+        if (mOptions.imus && reader.isImuStreamAvailable()) {
+            if (const auto imus = reader.getImuTimeRange(startTime, endTime); imus.has_value() && !imus->empty()) {
+                data.add("imus", kit::IMUStorage(kit::IMUPacket(*imus)));
+            }
+        }
+        if (mOptions.triggers && reader.isTriggerStreamAvailable()) {
+            if (const auto triggers = reader.getTriggersTimeRange(startTime, endTime); triggers.has_value() && !triggers->empty()) {
+                data.add("triggers", kit::TriggerStorage(kit::TriggerPacket(*triggers)));
+            }
+        }
+
+        return data;
+    }
+
+    /** The recording is opened once and kept for streaming and range reads */
+    dv::io::MonoCameraRecording &_recording() {
+        if (mRecording == nullptr) {
+            mRecording       = std::make_unique<dv::io::MonoCameraRecording>(mFilePath);
+            mEventResolution = mRecording->getEventResolution();
+            mFrameResolution = mRecording->getFrameResolution();
+
+            // Streaming covers the time range of the options only
+            const auto [startTime, endTime] = mRecording->getTimeRange();
+            mChunkTime = std::max(startTime, mOptions.startTime);
+            mReadTime  = mChunkTime;
+            mEndTime   = std::min(endTime, mOptions.endTime - 1);
+        }
+        return *mRecording;
+    }
+
+    /** Make sure everything before `time` has been read into the pending chunk */
+    void _read_until(const int64_t time) {
+        if (time <= mReadTime) {
+            return;
+        }
+        mPending.add(_read_time_range(_recording(), mReadTime, time));
+        mReadTime = time;
+    }
+
+    /**
+     * @brief Duration expected to hold `events` events given that `read` events were
+     * found within the last `step`, at most twice the step and the maximum read-ahead.
+     */
+    [[nodiscard]] int64_t _estimate_read_ahead(const int64_t step, const size_t read, const size_t events) const {
+        const int64_t grown = std::min(step * 2, mMaxReadAhead);
+        if (read == 0) {
+            return grown;
+        }
+        const double estimate = static_cast<double>(step) * static_cast<double>(events) / static_cast<double>(read);
+        return std::clamp(static_cast<int64_t>(std::min(estimate, static_cast<double>(grown))), int64_t(1), grown);
+    }
+
+    /** Hand out the pending data before `time`, the rest stays pending */
+    MonoCameraData _cut_pending(const int64_t time) {
+        auto chunk = mPending.sliceByTime("", mChunkTime, time);
+        mPending   = mPending.sliceByTime("", time, std::numeric_limits<int64_t>::max());
+        mChunkTime = time;
+        return chunk;
+    }
+
+    /**
+     * @brief CSV files hold events only, one `timestamp,x,y,polarity` line per event.
+     * Options are applied while parsing, filtered events are never stored.
+     */
+    MonoCameraData _load_from_csv() {
+        dv::toolkit::MonoCameraData data;
+        if (!mOptions.events) {
+            return data;
+        }
+        data["events"] = csv::readEvents(mFilePath, csv::ReadConfig(), [this](const dv::Event &event) {
+            return event.timestamp() >= mOptions.startTime && event.timestamp() < mOptions.endTime
+                && mOptions.accepts(event);
+        });
+        return data;
+    }
+
+    /** Cache files are mapped rather than decoded, loading only builds the shard index */
+    MonoCameraData _load_from_cache() {
+        auto contents    = cache::load(mFilePath);
+        mEventResolution = contents.eventResolution;
+        mFrameResolution = contents.frameResolution;
+        return _select(contents.data);
+    }
+
+    /** Prophesee raw recordings in EVT 2.0 or 3.0 encoding, decoded chunk by chunk */
+    MonoCameraData _load_from_raw() {
+        evt::RawReader reader(mFilePath);
+        mEventResolution = reader.getResolution();
+
+        // Options are applied chunk by chunk, a decoded chunk is the only unfiltered data
+        dv::toolkit::MonoCameraData data;
+        while (const auto chunk = reader.next()) {
+            data.add(_select(*chunk));
+        }
+        return data;
+    }
+
+    /**
+     * @brief Borders of the segments covering [startTime, endTime], taken from the packet
+     * index of the event stream. A border only falls between two packets which do not
+     * overlap in time, so every event packet is decompressed by a single segment.
+     * Recordings without event packets are split at fixed times instead.
+     */
+    [[nodiscard]] std::vector<int64_t> _segment_borders(const int64_t startTime, const int64_t endTime, const int64_t segment) const {
+        // Only the file header and the packet index are parsed, no packet is decoded
+        const dv::io::ReadOnlyFile file(mFilePath);
+        const auto &info = file.getFileInfo();
+
+        std::vector<std::pair<int64_t, int64_t>> packets;
+        for (const auto &stream : info.mStreams) {
+            if (stream.mTypeIdentifier != dv::EventPacket::TableType::identifier()) {
+                continue;
+            }
+            if (const auto table = info.mPerStreamDataTables.find(stream.mId); table != info.mPerStreamDataTables.end()) {
+                for (const auto &packet : table->second.Table) {
+                    packets.emplace_back(packet.TimestampStart, packet.TimestampEnd);
+                }
+            }
+            break;
+        }
+        std::sort(packets.begin(), packets.end());
+
+        std::vector<int64_t> borders{startTime};
+        if (packets.empty()) {
+            for (int64_t time = startTime; endTime - time >= segment; time += segment) {
+                borders.push_back(time + segment);
+            }
+        } else {
+            int64_t covered = std::numeric_limits<int64_t>::min();
+            for (const auto &[first, last] : packets) {
+                if (first > covered && first <= endTime && first - borders.back() >= segment) {
+                    borders.push_back(first);
+                }
+                covered = std::max(covered, last);
+            }
+        }
+        if (borders.back() <= endTime) {
+            borders.push_back(endTime + 1);
+        }
+        return borders;
+    }
+
+    MonoCameraData _load_from_aedat4_parallel(const ParallelReadConfig &config) {
+        const auto [recordingStart, recordingEnd] = _recording().getTimeRange();
+        const int64_t startTime = std::max(recordingStart, mOptions.startTime);
+        const int64_t endTime   = std::min(recordingEnd, mOptions.endTime - 1);
+        const int64_t segment   = std::max<int64_t>(1, config.segmentDuration.count());
+        if (endTime < startTime) {
+            return MonoCameraData();
+        }
+        const auto borders = _segment_borders(startTime, endTime, segment);
+
+        // Each worker decodes with its own recording instance, instances are reused
+        // by later segments once they are released
+        std::mutex mutex;
+        std::vector<std::unique_ptr<dv::io::MonoCameraRecording>> instances;
+        const auto readSegment = [this, &mutex, &instances](const int64_t from, const int64_t to) {
+            std::unique_ptr<dv::io::MonoCameraRecording> instance;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!instances.empty()) {
+                    instance = std::move(instances.back());
+                    instances.pop_back();
+                }
+            }
+            if (instance == nullptr) {
+                instance = std::make_unique<dv::io::MonoCameraRecording>(mFilePath);
+            }
+
+            auto data = _read_time_range(*instance, from, to);
+            
+            std::lock_guard<std::mutex> lock(mutex);
+            instances.push_back(std::move(instance));
+            return data;
+        };
+
+        kit::ThreadPool pool(config.numThreads);
+        const size_t prefetchDepth = std::max<size_t>(1, config.prefetchDepth);
+
+        // Segments are decoded out of order but appended in time order, at most
+        // prefetchDepth segments are in flight at once
+        dv::toolkit::MonoCameraData data;
+        std::deque<std::future<MonoCameraData>> inFlight;
+        size_t next = 1;
+        while (next < borders.size() || !inFlight.empty()) {
+            while (next < borders.size() && inFlight.size() < prefetchDepth) {
+                const int64_t from = borders[next - 1];
+                const int64_t to   = borders[next];
+                inFlight.push_back(pool.submit([&readSegment, from, to] {
+                    return readSegment(from, to);
+                }));
+                next++;
+            }
+
+            data.add(inFlight.front().get());
+            inFlight.pop_front();
+        }
 
         return data;
     }
@@ -54,36 +418,192 @@ private:
     enum class FileType {
         AEDAT4,
         CSV,
+        CACHE,
+        RAW,
     };
 
     std::unordered_map<std::string, FileType> mSupportTable = {
         {".aedat4", FileType::AEDAT4},
-        {".csv",    FileType::CSV}
+        {".csv",    FileType::CSV},
+        {".dvtk",   FileType::CACHE},
+        {".raw",    FileType::RAW}
     };
 
+    using UnifiedType = MonoCameraData::UnifiedType;
+
     fs::path mFilePath;
     fs::path mFileExtension;
+    ReadOptions mOptions;
     std::optional<cv::Size> mEventResolution;
     std::optional<cv::Size> mFrameResolution;
 
+    std::unique_ptr<dv::io::MonoCameraRecording> mRecording;
+    /** Streaming state, pending data covers [mChunkTime, mReadTime) */
+    MonoCameraData mPending;
+    int64_t mChunkTime = 0;
+    int64_t mReadTime  = 0;
+    int64_t mEndTime   = 0;
+    /** Duration read ahead at once when streaming by number of events, adapted to the event rate */
+    int64_t mReadAhead    = 10000;
+    int64_t mMaxReadAhead = 1000000;
+
 public:
-    MonoCameraReader(const fs::path &path) :
+    /**
+     * @param path 		Path of the recording
+     * @param options 	Streams, region, polarity and time range to load, applied by every
+     * 					loading method while decoding
+     */
+    MonoCameraReader(const fs::path &path, const ReadOptions &options = ReadOptions()) :
         mFilePath(path),
         mFileExtension(path.extension()),
+        mOptions(options),
         mEventResolution(std::nullopt),
         mFrameResolution(std::nullopt) {
     }
 
+    /**
+     * @brief Load the whole recording with several decoding threads. The time range is
+     * split at packet boundaries into segments which are read and decompressed 
+     * concurrently, each worker using its own recording instance, and appended in 
+     * time order. Other file types are loaded sequentially.
+     */
+    MonoCameraData loadData(const ParallelReadConfig &config) {
+		switch (mSupportTable[mFileExtension.string()]) {
+			case FileType::AEDAT4:
+                return _load_from_aedat4_parallel(config);
+                break;
+			case FileType::CSV:
+                return _load_from_csv();
+                break;
+			case FileType::CACHE:
+                return _load_from_cache();
+                break;
+			case FileType::RAW:
+                return _load_from_raw();
+                break;
+			default:
+				throw std::runtime_error("Unsupported file type");
+		} 
+    }
+
     MonoCameraData loadData() {
 		switch (mSupportTable[mFileExtension.string()]) {
 			case FileType::AEDAT4:
                 return _load_from_aedat4();
+                break;
+			case FileType::CSV:
+                return _load_from_csv();
+                break;
+			case FileType::CACHE:
+                return _load_from_cache();
+                break;
+			case FileType::RAW:
+                return _load_from_raw();
                 break;
 			default:
 				throw std::runtime_error("Unsupported file type");
 		} 
     }
 
+    /**
+     * @brief Next chunk of all streams covering `maxDuration`, chunks follow each other
+     * without gaps or overlap. Only the chunk itself is held in memory.
+     * 
+     * @return The chunk, or std::nullopt once the recording is exhausted.
+     */
+    [[nodiscard]] std::optional<MonoCameraData> next(const dv::Duration maxDuration) {
+        if (maxDuration.count() <= 0) {
+            throw std::invalid_argument("Chunk duration must be greater than zero");
+        }
+
+        _recording();
+        if (mChunkTime > mEndTime) {
+            return std::nullopt;
+        }
+
+        const int64_t endTime = mChunkTime + maxDuration.count();
+        _read_until(endTime);
+        return _cut_pending(endTime);
+    }
+
+    /**
+     * @brief Next chunk of all streams holding at most `maxEvents` events. Chunks are
+     * cut at an event timestamp, so all streams stay aligned; a chunk only exceeds 
+     * the limit when more events share a single timestamp.
+     * 
+     * @return The chunk, or std::nullopt once the recording is exhausted.
+     */
+    [[nodiscard]] std::optional<MonoCameraData> next(const size_t maxEvents) {
+        if (maxEvents == 0) {
+            throw std::invalid_argument("Chunk size must be greater than zero");
+        }
+
+        _recording();
+        if (mChunkTime > mEndTime) {
+            return std::nullopt;
+        }
+
+        // Read ahead until the event following the chunk is known. Each step is sized
+        // from the event rate of the previous one to bring the missing events only, so
+        // the pending data stays close to the limit; the step at most doubles while
+        // the rate is low and never exceeds the maximum read-ahead duration.
+        int64_t readAhead = mReadAhead;
+        while (mPending.size("events") <= maxEvents && mReadTime <= mEndTime) {
+            const size_t before = mPending.size("events");
+            _read_until(mReadTime + readAhead);
+
+            const size_t read    = mPending.size("events") - before;
+            const size_t missing = maxEvents + 1 - std::min(mPending.size("events"), maxEvents + 1);
+            mReadAhead           = _estimate_read_ahead(readAhead, read, maxEvents + 1);
+            readAhead            = _estimate_read_ahead(readAhead, read, missing);
+        }
+
+        if (mPending.size("events") <= maxEvents) {
+            return _cut_pending(mEndTime + 1);
+        }
+
+        const int64_t boundary = mPending.events().at(maxEvents).timestamp();
+        return _cut_pending(std::max(boundary, mChunkTime + 1));
+    }
+
+    /**
+     * @brief Load all streams within [startTime, endTime). The recording's packet time 
+     * index is parsed once when the file is first opened and kept with the cached
+     * instance, so only the packets overlapping the range are decoded.
+     */
+    [[nodiscard]] MonoCameraData loadRange(const int64_t startTime, const int64_t endTime) {
+        if (endTime < startTime) {
+            throw std::invalid_argument("End time of the range precedes its start time");
+        }
+        return _read_time_range(_recording(), startTime, endTime);
+    }
+
+    /**
+     * @brief Move the streaming position, the next chunk returned by next() starts at
+     * the given time.
+     */
+    void seek(const int64_t time) {
+        _recording();
+        mPending   = MonoCameraData();
+        mChunkTime = time;
+        mReadTime  = time;
+    }
+
+    /**
+     * @brief Time range covered by all streams of the recording.
+     */
+    [[nodiscard]] dv::TimeWindow getTimeRange() {
+        const auto [startTime, endTime] = _recording().getTimeRange();
+        return dv::TimeWindow(startTime, endTime);
+    }
+
+    /**
+     * @brief Restart streaming from the beginning of the recording.
+     */
+    void rewind() {
+        seek(std::max(_recording().getTimeRange().first, mOptions.startTime));
+    }
+
     [[nodiscard]] std::optional<cv::Size> getResolution(const std::string &name) const {
         if (name == "frame") {
             return mFrameResolution;
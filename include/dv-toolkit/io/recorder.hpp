@@ -0,0 +1,317 @@
+#pragma once
+
+#include "../core/core.hpp"
+#include "../core/base/concurrency.hpp"
+#include "./writer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace dv::toolkit::io {
+
+/**
+ * @brief Settings of a live recorder.
+ */
+struct RecorderConfig {
+    /** Chunks the producer may queue ahead of the capture thread */
+    size_t queueCapacity = 1024;
+    /** A buffer collects chunks for this long before it is handed to the flush thread */
+    dv::Duration flushInterval = dv::Duration(500000);
+    /**
+     * Chunks a buffer collects at most, a full buffer is handed over early. While the
+     * flush thread still writes the other one, chunks wait in the queue and are
+     * dropped once it is full, so memory stays bounded when the disk falls behind.
+     */
+    size_t bufferCapacity = 1024;
+    /** Wait of the capture thread while the queue is empty */
+    dv::Duration pollInterval = dv::Duration(200);
+    /** Output settings */
+    WriteConfig writeConfig;
+};
+
+struct RecorderStatistics {
+    /** Number of chunks collected for writing */
+    size_t received{0};
+    /**
+     * Number of chunks rejected because the queue was full or they were out of
+     * order with a chunk collected before, written or not
+     */
+    size_t dropped{0};
+    /** Number of buffers written to disk */
+    size_t flushes{0};
+    /** Time needed to write a buffer */
+    dv::Duration lastLatency{0};
+    dv::Duration maxLatency{0};
+    dv::Duration meanLatency{0};
+};
+
+/**
+ * @brief Records chunks of a live source to an aedat4 file without ever
+ * blocking the source. The producer hands chunks over through a lock-free
+ * single-producer single-consumer queue, a capture thread collects them into
+ * one buffer while a flush thread writes the other one to disk. A chunk is
+ * dropped, not waited for, when the queue is full. Buffers are bounded, if the
+ * disk cannot keep up the queue fills and chunks are dropped.
+ *
+ * push() must always be called from the same thread.
+ */
+class MonoCameraRecorder {
+private:
+    MonoCameraWriter mWriter;
+    RecorderConfig mConfig;
+    kit::SpscQueue<MonoCameraData> mQueue;
+
+    /** Buffer handed to the flush thread, valid while mBackReady is set */
+    MonoCameraData mBack;
+    bool mBackReady = false;
+    bool mCaptureDone = false;
+    RecorderStatistics mStatistics;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+
+    /** Highest timestamp of every stream collected so far, used by the capture thread only */
+    std::map<std::string, int64_t> mHighestTimes;
+
+    std::atomic<bool> mRunning{true};
+    std::atomic<size_t> mReceived{0};
+    std::atomic<size_t> mDropped{0};
+    std::exception_ptr mError;
+    std::atomic<bool> mFailed{false};
+
+    std::thread mCaptureThread;
+    std::thread mFlushThread;
+
+    /** Give the buffer to the flush thread unless it is still writing the previous one */
+    bool _hand_over(MonoCameraData &front, const bool wait) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            if (wait) {
+                mCondition.wait(lock, [this] {
+                    return !mBackReady;
+                });
+            } else if (mBackReady) {
+                return false;
+            }
+            mBack      = std::move(front);
+            mBackReady = true;
+        }
+        mCondition.notify_all();
+        front = MonoCameraData();
+        return true;
+    }
+
+    /**
+     * @brief Whether every stream of the chunk can be appended to the buffer and
+     * follows the chunks collected before, including those already handed to the
+     * flush thread. Checked up front so a rejected chunk leaves the buffer untouched.
+     */
+    [[nodiscard]] bool _fits(const MonoCameraData &front, const MonoCameraData &chunk) const {
+        for (const auto &[key, value] : chunk) {
+            const auto target = front.find(key);
+            // A new stream is created with the first storage type
+            if (value.index() != ((target == front.end()) ? 0 : target->second.index())) {
+                return false;
+            }
+
+            const auto highest = mHighestTimes.find(key);
+            if (highest == mHighestTimes.end()) {
+                continue;
+            }
+            const bool ordered = std::visit(
+                [&highest](const auto &store) {
+                    return store.isEmpty() || highest->second <= store.getLowestTime();
+                }, value);
+            if (!ordered) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void _collect(MonoCameraData &front, const MonoCameraData &chunk) {
+        front.add(chunk);
+        for (const auto &[key, value] : chunk) {
+            std::visit(
+                [this, &key](const auto &store) {
+                    if (!store.isEmpty()) {
+                        mHighestTimes[key] = store.getHighestTime();
+                    }
+                }, value);
+        }
+    }
+
+    void _capture() {
+        MonoCameraData front;
+        size_t collected = 0;
+        auto bufferStart = std::chrono::steady_clock::now();
+
+        while (true) {
+            // Read the flag before draining, every chunk pushed before stop() is collected
+            const bool stopping = !mRunning.load();
+
+            bool idle = true;
+            while (true) {
+                // A full buffer is handed over early, while the flush thread is busy the
+                // remaining chunks stay in the queue
+                if (collected >= mConfig.bufferCapacity) {
+                    if (!_hand_over(front, stopping)) {
+                        break;
+                    }
+                    collected   = 0;
+                    bufferStart = std::chrono::steady_clock::now();
+                }
+
+                auto chunk = mQueue.tryPop();
+                if (!chunk.has_value()) {
+                    break;
+                }
+                idle = false;
+                if (!_fits(front, *chunk)) {
+                    mDropped++;
+                    continue;
+                }
+                _collect(front, *chunk);
+                collected++;
+                mReceived++;
+            }
+
+            if (collected > 0) {
+                const bool due = std::chrono::steady_clock::now() - bufferStart >= mConfig.flushInterval;
+                if ((stopping || due) && _hand_over(front, stopping)) {
+                    collected   = 0;
+                    bufferStart = std::chrono::steady_clock::now();
+                }
+            }
+
+            if (stopping && collected == 0 && mQueue.size() == 0) {
+                break;
+            }
+            if (idle) {
+                std::this_thread::sleep_for(mConfig.pollInterval);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mCaptureDone = true;
+        }
+        mCondition.notify_all();
+    }
+
+    void _flush() {
+        while (true) {
+            MonoCameraData buffer;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [this] {
+                    return mBackReady || mCaptureDone;
+                });
+                if (!mBackReady) {
+                    break;
+                }
+                buffer = std::move(mBack);
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            if (!mFailed) {
+                try {
+                    mWriter.append(buffer);
+                } catch (...) {
+                    mError  = std::current_exception();
+                    mFailed = true;
+                }
+            }
+            const auto latency = std::chrono::duration_cast<dv::Duration>(std::chrono::steady_clock::now() - start);
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mBackReady = false;
+                mStatistics.flushes++;
+                mStatistics.lastLatency = latency;
+                mStatistics.maxLatency  = std::max(mStatistics.maxLatency, latency);
+                mStatistics.meanLatency = mStatistics.meanLatency
+                    + (latency - mStatistics.meanLatency) / static_cast<int64_t>(mStatistics.flushes);
+            }
+            mCondition.notify_all();
+        }
+
+        try {
+            mWriter.close();
+        } catch (...) {
+            if (!mFailed) {
+                mError  = std::current_exception();
+                mFailed = true;
+            }
+        }
+    }
+
+public:
+    MonoCameraRecorder(const fs::path &path, const cv::Size &resolution, const RecorderConfig &config = RecorderConfig()) :
+        mWriter(path, resolution, config.writeConfig),
+        mConfig(config),
+        mQueue(config.queueCapacity) {
+        if (!mWriter.canAppend()) {
+            throw std::invalid_argument("Recording is only supported for aedat4 files");
+        }
+        mCaptureThread = std::thread([this] {
+            _capture();
+        });
+        mFlushThread = std::thread([this] {
+            _flush();
+        });
+    }
+
+    MonoCameraRecorder(const MonoCameraRecorder &other)            = delete;
+    MonoCameraRecorder &operator=(const MonoCameraRecorder &other) = delete;
+
+    ~MonoCameraRecorder() {
+        try {
+            stop();
+        } catch (...) {
+        }
+    }
+
+    /**
+     * @brief Hand a chunk to the recorder, never blocks. Chunks must follow each
+     * other in time.
+     *
+     * @return False if the chunk was dropped.
+     */
+    bool push(MonoCameraData chunk) {
+        if (!mRunning.load(std::memory_order_relaxed) || mFailed.load(std::memory_order_relaxed)
+            || !mQueue.tryPush(std::move(chunk))) {
+            mDropped++;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Write everything pushed so far and finalize the file. Errors of
+     * the writing thread are rethrown here.
+     */
+    void stop() {
+        if (mRunning.exchange(false)) {
+            mCaptureThread.join();
+            mFlushThread.join();
+        }
+        if (mFailed) {
+            std::rethrow_exception(mError);
+        }
+    }
+
+    [[nodiscard]] RecorderStatistics statistics() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        RecorderStatistics statistics = mStatistics;
+        statistics.received = mReceived.load();
+        statistics.dropped  = mDropped.load();
+        return statistics;
+    }
+};
+
+} // namespace dv::toolkit::io
@@ -0,0 +1,238 @@
+#pragma once
+
+#include "../core/core.hpp"
+#include "./cache.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace dv::toolkit::io::shm {
+
+/**
+ * @brief Mapping of a POSIX shared memory object. The name identifies the
+ * object across processes, the memory itself is released once the name is
+ * unlinked and every process has dropped its mapping.
+ */
+class SharedMemory {
+private:
+	char *mData = nullptr;
+	size_t mSize = 0;
+	std::string mName;
+	bool mOwner = false;
+
+	SharedMemory(char *data, const size_t size, std::string name, const bool owner) :
+		mData(data),
+		mSize(size),
+		mName(std::move(name)),
+		mOwner(owner) {
+	}
+
+	static std::string failure(const std::string &action, const std::string &name) {
+		return "Failed to " + action + " shared memory " + name + ": " + std::strerror(errno);
+	}
+
+public:
+	/**
+	 * @brief Create a new object of `size` bytes mapped for writing. The object
+	 * is unlinked on destruction unless ownership of the name is released.
+	 */
+	[[nodiscard]] static std::shared_ptr<SharedMemory> create(const std::string &name, const size_t size) {
+		const int descriptor = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+		if (descriptor < 0) {
+			throw std::runtime_error(failure("create", name));
+		}
+		if (ftruncate(descriptor, static_cast<off_t>(size)) != 0) {
+			::close(descriptor);
+			shm_unlink(name.c_str());
+			throw std::runtime_error(failure("resize", name));
+		}
+
+		void *address = mmap(nullptr, std::max<size_t>(size, 1), PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+		::close(descriptor);
+		if (address == MAP_FAILED) {
+			shm_unlink(name.c_str());
+			throw std::runtime_error(failure("map", name));
+		}
+		return std::shared_ptr<SharedMemory>(new SharedMemory(static_cast<char *>(address), size, name, true));
+	}
+
+	/**
+	 * @brief Map an existing object read-only.
+	 */
+	[[nodiscard]] static std::shared_ptr<const SharedMemory> open(const std::string &name) {
+		const int descriptor = shm_open(name.c_str(), O_RDONLY, 0);
+		if (descriptor < 0) {
+			throw std::runtime_error(failure("open", name));
+		}
+
+		struct stat status {};
+		if (fstat(descriptor, &status) != 0) {
+			::close(descriptor);
+			throw std::runtime_error(failure("stat", name));
+		}
+
+		const auto size = static_cast<size_t>(status.st_size);
+		void *address   = mmap(nullptr, std::max<size_t>(size, 1), PROT_READ, MAP_SHARED, descriptor, 0);
+		::close(descriptor);
+		if (address == MAP_FAILED) {
+			throw std::runtime_error(failure("map", name));
+		}
+		return std::shared_ptr<const SharedMemory>(new SharedMemory(static_cast<char *>(address), size, name, false));
+	}
+
+	SharedMemory(const SharedMemory &other)            = delete;
+	SharedMemory &operator=(const SharedMemory &other) = delete;
+
+	~SharedMemory() {
+		munmap(mData, std::max<size_t>(mSize, 1));
+		if (mOwner) {
+			shm_unlink(mName.c_str());
+		}
+	}
+
+	/**
+	 * @brief Keep the object after destruction, the process attaching it takes
+	 * over the responsibility to unlink it.
+	 */
+	void release() noexcept {
+		mOwner = false;
+	}
+
+	[[nodiscard]] char *data() noexcept {
+		return mData;
+	}
+
+	[[nodiscard]] const char *data() const noexcept {
+		return mData;
+	}
+
+	[[nodiscard]] size_t size() const noexcept {
+		return mSize;
+	}
+
+	[[nodiscard]] const std::string &name() const noexcept {
+		return mName;
+	}
+};
+
+namespace internal {
+
+/** Measures the layout without writing it */
+class SizeCounter {
+private:
+	uint64_t mPosition = 0;
+	uint64_t mEnd      = 0;
+
+public:
+	void write(const void *, const size_t bytes) {
+		mPosition += bytes;
+		mEnd = std::max(mEnd, mPosition);
+	}
+
+	void pad(const uint64_t multiple) {
+		write(nullptr, (multiple - mPosition % multiple) % multiple);
+	}
+
+	void seek(const uint64_t position) {
+		mPosition = position;
+	}
+
+	[[nodiscard]] uint64_t position() const noexcept {
+		return mPosition;
+	}
+
+	[[nodiscard]] uint64_t size() const noexcept {
+		return mEnd;
+	}
+};
+
+/** Writes the layout into memory sized by SizeCounter */
+class MemoryWriter {
+private:
+	char *mData;
+	uint64_t mSize;
+	uint64_t mPosition = 0;
+
+public:
+	MemoryWriter(char *data, const uint64_t size) : mData(data), mSize(size) {
+	}
+
+	void write(const void *data, const size_t bytes) {
+		if (bytes > mSize - mPosition) {
+			throw std::length_error("Shared memory layout exceeds the measured size");
+		}
+		if (bytes > 0) {
+			std::memcpy(mData + mPosition, data, bytes);
+		}
+		mPosition += bytes;
+	}
+
+	void pad(const uint64_t multiple) {
+		// Fresh shared memory objects are zero filled
+		mPosition += (multiple - mPosition % multiple) % multiple;
+	}
+
+	void seek(const uint64_t position) {
+		mPosition = position;
+	}
+
+	[[nodiscard]] uint64_t position() const noexcept {
+		return mPosition;
+	}
+};
+
+[[nodiscard]] inline std::string uniqueName() {
+	static std::atomic<uint64_t> counter{0};
+	static const uint64_t salt = std::random_device()();
+	return "/dvtk-" + std::to_string(getpid()) + "-" + std::to_string(salt) + "-" + std::to_string(counter++);
+}
+
+} // namespace internal
+
+/**
+ * @brief Copy camera data into a new shared memory object, laid out like the
+ * native cache format. The returned handle's name is the descriptor another
+ * process passes to attach().
+ *
+ * @param name 	Name of the object, a unique name is generated when empty
+ */
+[[nodiscard]] inline std::shared_ptr<SharedMemory> exportData(const MonoCameraData &data,
+	const std::optional<cv::Size> &eventResolution = std::nullopt,
+	const std::optional<cv::Size> &frameResolution = std::nullopt, const std::string &name = "") {
+	internal::SizeCounter counter;
+	cache::internal::serialize(counter, data, eventResolution, frameResolution);
+
+	auto memory = SharedMemory::create(name.empty() ? internal::uniqueName() : name, counter.size());
+	internal::MemoryWriter writer(memory->data(), memory->size());
+	cache::internal::serialize(writer, data, eventResolution, frameResolution);
+	return memory;
+}
+
+/**
+ * @brief Attach camera data exported by another process. Events, IMUs and
+ * triggers become read-only shards referencing the shared pages, nothing is
+ * copied; frames are copied as the cache format does. The mapping stays alive
+ * as long as any storage or slice refers to it.
+ *
+ * @param unlink 	Remove the name right away, the memory is released once the
+ * 					attached storages are gone. Used when the exporter released
+ * 					ownership to hand data over.
+ */
+[[nodiscard]] inline cache::Contents attach(const std::string &name, const bool unlink = false) {
+	const auto memory = SharedMemory::open(name);
+	if (unlink) {
+		shm_unlink(name.c_str());
+	}
+	return cache::internal::parse(memory, name);
+}
+
+} // namespace dv::toolkit::io::shm
@@ -1,6 +1,16 @@
+#pragma once
+
 #include "../core/core.hpp"
+#include "../core/base/concurrency.hpp"
+#include "./cache.hpp"
+#include "./csv.hpp"
 #include <dv-processing/io/mono_camera_writer.hpp>
 
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+
 
 namespace fs = std::filesystem;
 namespace kit = dv::toolkit;
@@ -9,60 +19,244 @@ namespace dv::toolkit::io {
 
 using namespace std::chrono_literals;
 
+/**
+ * @brief Settings of aedat4 output.
+ */
+struct WriteConfig {
+    /** Camera name stored in the file */
+    std::string cameraName = "test";
+    /** Packet compression, LZ4_HIGH and ZSTD_HIGH trade speed for smaller files */
+    dv::CompressionType compression = dv::CompressionType::LZ4;
+};
+
 class MonoCameraWriter {
 private:
-    void _write_to_aedat4(const MonoCameraData &data) {
-        // dv::io::MonoCameraWriter::DAVISConfig config("DVXplorer_sample");
-        dv::io::MonoCameraWriter::Config config = dv::io::MonoCameraWriter::DAVISConfig("test", mResolution);
+    /** The output file is opened by the first append and finalized by close() */
+    dv::io::MonoCameraWriter &_recording() {
+        if (mRecording == nullptr) {
+            auto config        = dv::io::MonoCameraWriter::DAVISConfig(mConfig.cameraName, mResolution);
+            config.compression = mConfig.compression;
+            mRecording         = std::make_unique<dv::io::MonoCameraWriter>(mFilePath, config);
+        }
+        return *mRecording;
+    }
 
-        // Create the writer instance with the configuration structure
-        dv::io::MonoCameraWriter writer(mFilePath, config);
+    /**
+     * @brief Write every shard as a packet of its own, elements are copied once
+     * straight from the shard into the packet.
+     */
+    template<class PacketType, class StorageType, class WriteFunction>
+    static void _write_shards(const StorageType &store, WriteFunction &&write) {
+        for (const auto &partial : store.partials()) {
+            if (partial.getLength() == 0) {
+                continue;
+            }
+            PacketType packet;
+            packet.elements.assign(partial.begin(), partial.end());
+            write(packet);
+        }
+    }
+
+    void _append_to_aedat4(const MonoCameraData &data) {
+        auto &writer = _recording();
+
+        _write_shards<dv::EventPacket>(data.events(), [&writer](const dv::EventPacket &packet) {
+            writer.writeEventPacket(packet);
+        });
 
-        writer.writeEvents(data.events().toEventStore());
-        
         for (const auto &frame : data.frames()) {
             writer.writeFrame(frame);
         }
 
-        for (const auto &imu : data.imus()) {
-            writer.writeImu(imu);
-        }
+        _write_shards<dv::IMUPacket>(data.imus(), [&writer](const dv::IMUPacket &packet) {
+            writer.writeImuPacket(packet);
+        });
 
-        for (const auto &trigger : data.triggers()) {
-            writer.writeTrigger(trigger);
-        }
+        _write_shards<dv::TriggerPacket>(data.triggers(), [&writer](const dv::TriggerPacket &packet) {
+            writer.writeTriggerPacket(packet);
+        });
     }
 
     enum class FileType {
         AEDAT4,
         CSV,
+        CACHE,
     };
 
     std::unordered_map<std::string, FileType> mSupportTable = {
         {".aedat4", FileType::AEDAT4},
-        {".csv",    FileType::CSV}
+        {".csv",    FileType::CSV},
+        {".dvtk",   FileType::CACHE}
     };
 
     fs::path mFilePath;
     fs::path mFileExtension;
     cv::Size mResolution;
+    WriteConfig mConfig;
+
+    std::unique_ptr<dv::io::MonoCameraWriter> mRecording;
 
 public:
-    MonoCameraWriter(const fs::path &path, const cv::Size &resolution) :
+    MonoCameraWriter(const fs::path &path, const cv::Size &resolution, const WriteConfig &config = WriteConfig()) :
         mFilePath(path),
         mFileExtension(path.extension()),
-        mResolution(resolution) {
+        mResolution(resolution),
+        mConfig(config) {
     }
 
     void writeData(const MonoCameraData &data) {
 		switch (mSupportTable[mFileExtension.string()]) {
 			case FileType::AEDAT4:
-                _write_to_aedat4(data);
+                _append_to_aedat4(data);
+                close();
+                break;
+			case FileType::CSV:
+                // CSV files hold events only
+                csv::writeEvents(mFilePath, data.events());
+                break;
+			case FileType::CACHE:
+                cache::save(mFilePath, data, mResolution, mResolution);
                 break;
 			default:
 				throw std::runtime_error("Unsupported file type");
 		}
     }
+
+    /**
+     * @brief Append a chunk to the file, chunks must follow each other in time.
+     * The file is opened by the first chunk and stays open until close().
+     */
+    void append(const MonoCameraData &chunk) {
+        if (!canAppend()) {
+            throw std::runtime_error("Incremental writing is only supported for aedat4 files");
+        }
+        _append_to_aedat4(chunk);
+    }
+
+    /**
+     * @brief Finalize the file, a later append starts a new file at the same path.
+     */
+    void close() {
+        mRecording.reset();
+    }
+
+    [[nodiscard]] bool canAppend() const {
+        const auto type = mSupportTable.find(mFileExtension.string());
+        return type != mSupportTable.end() && type->second == FileType::AEDAT4;
+    }
+};
+
+/**
+ * @brief Writer appending chunks on a background thread. Chunks are queued,
+ * serialized and compressed off the calling thread; append() only blocks
+ * while the queue is full. Errors of the background thread are rethrown by
+ * the next append() or by close().
+ */
+class AsyncMonoCameraWriter {
+private:
+    MonoCameraWriter mWriter;
+    kit::BoundedQueue<MonoCameraData> mQueue;
+    std::exception_ptr mError;
+    std::atomic<bool> mFailed{false};
+    bool mClosed = false;
+    std::thread mWorker;
+
+    void work() {
+        while (const auto chunk = mQueue.pop()) {
+            // Chunks still queued after a failure are dropped, the first error is kept
+            if (mFailed) {
+                continue;
+            }
+            try {
+                mWriter.append(*chunk);
+            } catch (...) {
+                mError  = std::current_exception();
+                mFailed = true;
+                mQueue.close();
+            }
+        }
+
+        try {
+            mWriter.close();
+        } catch (...) {
+            if (!mFailed) {
+                mError  = std::current_exception();
+                mFailed = true;
+            }
+        }
+    }
+
+public:
+    AsyncMonoCameraWriter(const fs::path &path, const cv::Size &resolution, const size_t queueCapacity = 64,
+        const WriteConfig &config = WriteConfig()) :
+        mWriter(path, resolution, config),
+        mQueue(queueCapacity) {
+        if (!mWriter.canAppend()) {
+            throw std::invalid_argument("Incremental writing is only supported for aedat4 files");
+        }
+        mWorker = std::thread([this] {
+            work();
+        });
+    }
+
+    AsyncMonoCameraWriter(const AsyncMonoCameraWriter &other)            = delete;
+    AsyncMonoCameraWriter &operator=(const AsyncMonoCameraWriter &other) = delete;
+
+    ~AsyncMonoCameraWriter() {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+
+    /**
+     * @brief Queue a chunk for writing, waits while the queue is full. The
+     * chunk shares its shards with the caller, nothing is copied.
+     */
+    void append(MonoCameraData chunk) {
+        if (mFailed) {
+            std::rethrow_exception(mError);
+        }
+        if (!mQueue.push(std::move(chunk))) {
+            if (mFailed) {
+                std::rethrow_exception(mError);
+            }
+            throw std::runtime_error("Writer is closed");
+        }
+    }
+
+    /**
+     * @brief Queue a chunk only if the queue has space.
+     *
+     * @return False if the chunk was not queued.
+     */
+    bool tryAppend(MonoCameraData chunk) {
+        if (mFailed) {
+            std::rethrow_exception(mError);
+        }
+        return mQueue.tryPush(std::move(chunk));
+    }
+
+    /**
+     * @brief Write all queued chunks and finalize the file.
+     */
+    void close() {
+        if (!mClosed) {
+            mClosed = true;
+            mQueue.close();
+            mWorker.join();
+        }
+        if (mFailed) {
+            std::rethrow_exception(mError);
+        }
+    }
+
+    /**
+     * @brief Number of chunks waiting to be written.
+     */
+    [[nodiscard]] size_t pending() {
+        return mQueue.size();
+    }
 };
 
 } // namespace dv::toolkit::io
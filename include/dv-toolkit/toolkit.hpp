@@ -1,7 +1,13 @@
 #pragma once
 
 #include "core/core.hpp"
+#include "core/planner.hpp"
+#include "core/schema.hpp"
 #include "core/slicer.hpp"
+#include "core/static_slicer.hpp"
+#include "io/dataset.hpp"
 #include "io/reader.hpp"
+#include "io/recorder.hpp"
+#include "io/shm.hpp"
 #include "io/writer.hpp"
 #include "simulation/generator.hpp"
@@ -1,3 +1,4 @@
+#include <memory>
 #include <utility>
 
 #include <pybind11/chrono.h>
@@ -44,6 +45,18 @@ struct type_caster<cv::Size> {
 
 } // namespace pybind11::detail
 
+/**
+ * Destroys objects owning worker threads without holding the GIL. Joining the
+ * workers waits for pending callbacks, which have to acquire the GIL themselves.
+ */
+template<class Type>
+struct GilReleasingDeleter {
+	void operator()(Type *object) const {
+		py::gil_scoped_release release;
+		delete object;
+	}
+};
+
 PYBIND11_MODULE(_lib_toolkit, m) {
 	using pybind11::operator""_a;
 
@@ -128,6 +141,10 @@ PYBIND11_MODULE(_lib_toolkit, m) {
 		})
 		.def_static("GetFullyQualifiedName", &kit::TriggerPacket::GetFullyQualifiedName);
 
+	py::class_<kit::SpillFile, std::shared_ptr<kit::SpillFile>>(m, "SpillFile")
+		.def(py::init<const std::filesystem::path &, const uint64_t>(), "path"_a, "extentSize"_a = uint64_t(1) << 30)
+		.def("size", &kit::SpillFile::size);
+
     py::class_<kit::EventStorage>(m, "EventStorage")
         .def(py::init<>())
         .def(py::init<kit::EventPacket&>())
@@ -204,6 +221,8 @@ PYBIND11_MODULE(_lib_toolkit, m) {
 		.def("duration", &kit::EventStorage::duration)
 		.def("timeWindow", &kit::EventStorage::timeWindow)
 		.def("rate", &kit::EventStorage::rate)
+		.def("enableOutOfCore", &kit::EventStorage::enableOutOfCore, "scratch"_a, "memoryBudget"_a)
+		.def("isOutOfCore", &kit::EventStorage::isOutOfCore)
         .def("push_back",
 			[](kit::EventStorage &self, const int64_t timestamp, const int16_t x, const int16_t y, const bool polarity) {
 				return self.emplace_back(timestamp, x, y, polarity);
@@ -325,7 +344,9 @@ PYBIND11_MODULE(_lib_toolkit, m) {
 		.def("retainDuration", &kit::IMUStorage::retainDuration, "duration"_a)
 		.def("duration", &kit::IMUStorage::duration)
 		.def("timeWindow", &kit::IMUStorage::timeWindow)
-		.def("rate", &kit::IMUStorage::rate);
+		.def("rate", &kit::IMUStorage::rate)
+		.def("enableOutOfCore", &kit::IMUStorage::enableOutOfCore, "scratch"_a, "memoryBudget"_a)
+		.def("isOutOfCore", &kit::IMUStorage::isOutOfCore);
 
     py::class_<kit::TriggerStorage>(m, "TriggerStorage")
         .def(py::init<>())
@@ -375,7 +396,9 @@ PYBIND11_MODULE(_lib_toolkit, m) {
 		.def("retainDuration", &kit::TriggerStorage::retainDuration, "duration"_a)
 		.def("duration", &kit::TriggerStorage::duration)
 		.def("timeWindow", &kit::TriggerStorage::timeWindow)
-		.def("rate", &kit::TriggerStorage::rate);
+		.def("rate", &kit::TriggerStorage::rate)
+		.def("enableOutOfCore", &kit::TriggerStorage::enableOutOfCore, "scratch"_a, "memoryBudget"_a)
+		.def("isOutOfCore", &kit::TriggerStorage::isOutOfCore);
 
 	py::class_<kit::MonoCameraData>(m, "MonoCameraData")
 		.def(py::init<>())
@@ -415,6 +438,10 @@ PYBIND11_MODULE(_lib_toolkit, m) {
 			 [](const kit::MonoCameraData &self, const std::string &name, const int64_t start, const int64_t end) {
 				return self.sliceByTime(name, start, end);
 			 }, "name"_a, "start"_a, "end"_a)
+		.def("sliceByTimeBatch",
+			 [](const kit::MonoCameraData &self, const std::vector<dv::TimeWindow> &windows) {
+				return self.sliceByTimeBatch(windows);
+			 }, "windows"_a, py::call_guard<py::gil_scoped_release>())
 		.def("size", &kit::MonoCameraData::size)
 		.def("timeWindow", &kit::MonoCameraData::timeWindow)
 		.def("events", &kit::MonoCameraData::events)
@@ -460,12 +487,75 @@ PYBIND11_MODULE(_lib_toolkit, m) {
 			 [](const kit::CustomizedCameraData &self, const std::string &name, const int64_t start, const int64_t end) {
 				return self.sliceByTime(name, start, end);
 			 }, "name"_a, "start"_a, "end"_a)
+		.def("sliceByTimeBatch",
+			 [](const kit::CustomizedCameraData &self, const std::vector<dv::TimeWindow> &windows) {
+				return self.sliceByTimeBatch(windows);
+			 }, "windows"_a, py::call_guard<py::gil_scoped_release>())
 		.def("size", &kit::CustomizedCameraData::size)
 		.def("timeWindow", &kit::CustomizedCameraData::timeWindow);
 
-	py::class_<kit::MonoCameraSlicer>(m, "MonoCameraSlicer")
+	py::class_<kit::ClockModel>(m, "ClockModel")
+		.def(py::init<>())
+		.def_readwrite("offset", &kit::ClockModel::offset)
+		.def_readwrite("drift", &kit::ClockModel::drift)
+		.def_readwrite("pivot", &kit::ClockModel::pivot)
+		.def("toCommon", &kit::ClockModel::toCommon, "local"_a)
+		.def("toLocal", &kit::ClockModel::toLocal, "common"_a)
+		.def("isIdentity", &kit::ClockModel::isIdentity)
+		.def_static("estimate", &kit::ClockModel::estimate, "reference"_a, "local"_a, "maxDeviation"_a = -1);
+
+	py::class_<kit::MultiCameraData>(m, "MultiCameraData")
+		.def(py::init<>())
+		.def("__getitem__",
+			 [](kit::MultiCameraData &self, const std::string &name) -> kit::MonoCameraData & {
+				return self.at(name);
+			 }, py::return_value_policy::reference_internal)
+		.def("__setitem__",
+			 [](kit::MultiCameraData &self, const std::string &name, const kit::MonoCameraData &data) {
+				self[name] = data;
+			 })
+		.def("__len__",
+			 [](const kit::MultiCameraData &self) {
+				return self.size();
+			 })
+		.def("keys",
+			 [](const kit::MultiCameraData &self) {
+				std::vector<std::string> keys;
+				for (const auto &[key, value] : self) {
+					keys.push_back(key);
+				}
+				return keys;
+			 })
+		.def("add", &kit::MultiCameraData::add, "other"_a)
+		.def("clock", &kit::MultiCameraData::clock, "name"_a)
+		.def("setClock", &kit::MultiCameraData::setClock, "name"_a, "clock"_a)
+		.def("synchronize", &kit::MultiCameraData::synchronize, "reference"_a, "triggers"_a = "triggers")
+		.def("sliceByTime", &kit::MultiCameraData::sliceByTime, "start"_a, "end"_a)
+		.def("timeWindow", &kit::MultiCameraData::timeWindow, "name"_a);
+
+	py::class_<kit::StereoCameraData, kit::MultiCameraData>(m, "StereoCameraData")
+		.def(py::init<>());
+
+	py::enum_<kit::BackpressurePolicy>(m, "BackpressurePolicy")
+		.value("BLOCK", kit::BackpressurePolicy::BLOCK)
+		.value("DROP_OLDEST", kit::BackpressurePolicy::DROP_OLDEST)
+		.value("COALESCE", kit::BackpressurePolicy::COALESCE);
+
+	py::class_<kit::JobStatistics>(m, "JobStatistics")
 		.def(py::init<>())
-		.def("accept", &kit::MonoCameraSlicer::accept)
+		.def_readonly("queueDepth", &kit::JobStatistics::queueDepth)
+		.def_readonly("maxQueueDepth", &kit::JobStatistics::maxQueueDepth)
+		.def_readonly("dispatched", &kit::JobStatistics::dispatched)
+		.def_readonly("dropped", &kit::JobStatistics::dropped)
+		.def_readonly("coalesced", &kit::JobStatistics::coalesced)
+		.def_readonly("lastLatency", &kit::JobStatistics::lastLatency)
+		.def_readonly("maxLatency", &kit::JobStatistics::maxLatency)
+		.def_readonly("meanLatency", &kit::JobStatistics::meanLatency);
+
+	py::class_<kit::MonoCameraSlicer,
+		std::unique_ptr<kit::MonoCameraSlicer, GilReleasingDeleter<kit::MonoCameraSlicer>>>(m, "MonoCameraSlicer")
+		.def(py::init<>())
+		.def("accept", &kit::MonoCameraSlicer::accept, py::call_guard<py::gil_scoped_release>())
 		.def("doEveryNumberOfElements",
 			 [](kit::MonoCameraSlicer &self, const std::string &name, 
 			 	const size_t n, std::function<void(const kit::MonoCameraData &)> callback){
@@ -486,23 +576,339 @@ PYBIND11_MODULE(_lib_toolkit, m) {
 			 	const dv::Duration &interval, std::function<void(const dv::TimeWindow &, const kit::MonoCameraData &)> callback){
 					return self.doEveryTimeInterval(name, interval, std::move(callback));
 			 })
+		.def("doEveryNumberOfElements",
+			 [](kit::MonoCameraSlicer &self, const std::string &name, const size_t n,
+			 	const size_t stride, std::function<void(const kit::MonoCameraData &)> callback){
+					return self.doEveryNumberOfElements(name, n, stride, std::move(callback));
+			 })
+		.def("doEveryNumberOfElements",
+			 [](kit::MonoCameraSlicer &self, const std::string &name, const size_t n,
+			 	const size_t stride, std::function<void(const dv::TimeWindow &, const kit::MonoCameraData &)> callback){
+					return self.doEveryNumberOfElements(name, n, stride, std::move(callback));
+			 })
+		.def("doEveryTimeInterval",
+			 [](kit::MonoCameraSlicer &self, const std::string &name, const dv::Duration &window,
+			 	const dv::Duration &stride, std::function<void(const kit::MonoCameraData &)> callback){
+					return self.doEveryTimeInterval(name, window, stride, std::move(callback));
+			 })
+		.def("doEveryTimeInterval",
+			 [](kit::MonoCameraSlicer &self, const std::string &name, const dv::Duration &window,
+			 	const dv::Duration &stride, std::function<void(const dv::TimeWindow &, const kit::MonoCameraData &)> callback){
+					return self.doEveryTimeInterval(name, window, stride, std::move(callback));
+			 })
+		.def("doEveryFrameExposure",
+			 [](kit::MonoCameraSlicer &self, const std::string &name, const std::string &frames,
+			 	std::function<void(const kit::MonoCameraData &)> callback){
+					return self.doEveryFrameExposure(name, frames, std::move(callback));
+			 })
+		.def("doEveryFrameExposure",
+			 [](kit::MonoCameraSlicer &self, const std::string &name, const std::string &frames,
+			 	std::function<void(const dv::TimeWindow &, const kit::MonoCameraData &)> callback){
+					return self.doEveryFrameExposure(name, frames, std::move(callback));
+			 })
+		.def("doEveryBoundaryInterval",
+			 [](kit::MonoCameraSlicer &self, const std::string &name, const std::string &boundary,
+			 	std::function<void(const kit::MonoCameraData &)> callback){
+					return self.doEveryBoundaryInterval(name, boundary, std::move(callback));
+			 })
+		.def("doEveryBoundaryInterval",
+			 [](kit::MonoCameraSlicer &self, const std::string &name, const std::string &boundary,
+			 	std::function<void(const dv::TimeWindow &, const kit::MonoCameraData &)> callback){
+					return self.doEveryBoundaryInterval(name, boundary, std::move(callback));
+			 })
+		.def("doEveryEventDensity",
+			 [](kit::MonoCameraSlicer &self, const std::string &name, const cv::Size &resolution,
+			 	const int cellSize, const double threshold, const dv::Duration &minDuration,
+			 	const dv::Duration &maxDuration, std::function<void(const kit::MonoCameraData &)> callback){
+					return self.doEveryEventDensity(
+						name, resolution, cellSize, threshold, minDuration, maxDuration, std::move(callback));
+			 })
+		.def("doEveryEventDensity",
+			 [](kit::MonoCameraSlicer &self, const std::string &name, const cv::Size &resolution,
+			 	const int cellSize, const double threshold, const dv::Duration &minDuration,
+			 	const dv::Duration &maxDuration,
+			 	std::function<void(const dv::TimeWindow &, const kit::MonoCameraData &)> callback){
+					return self.doEveryEventDensity(
+						name, resolution, cellSize, threshold, minDuration, maxDuration, std::move(callback));
+			 })
 		.def("hasJob", &kit::MonoCameraSlicer::hasJob)
-		.def("removeJob", &kit::MonoCameraSlicer::removeJob)
+		.def("removeJob", &kit::MonoCameraSlicer::removeJob, py::call_guard<py::gil_scoped_release>())
 		.def("modifyTimeInterval", &kit::MonoCameraSlicer::modifyTimeInterval)
-		.def("modifyNumberInterval", &kit::MonoCameraSlicer::modifyNumberInterval);
+		.def("modifyNumberInterval", &kit::MonoCameraSlicer::modifyNumberInterval)
+		.def("modifyMaxLookback", &kit::MonoCameraSlicer::modifyMaxLookback, "jobId"_a, "maxLookback"_a)
+		.def("enableAsyncDispatch", &kit::MonoCameraSlicer::enableAsyncDispatch,
+			 "numThreads"_a, "queueCapacity"_a = 16, "policy"_a = kit::BackpressurePolicy::BLOCK,
+			 py::call_guard<py::gil_scoped_release>())
+		.def("disableAsyncDispatch", &kit::MonoCameraSlicer::disableAsyncDispatch,
+			 py::call_guard<py::gil_scoped_release>())
+		.def("isAsyncDispatch", &kit::MonoCameraSlicer::isAsyncDispatch)
+		.def("flush", &kit::MonoCameraSlicer::flush, py::call_guard<py::gil_scoped_release>())
+		.def("getJobStatistics", &kit::MonoCameraSlicer::getJobStatistics, "jobId"_a);
+
+	py::class_<kit::MultiCameraSlicer>(m, "MultiCameraSlicer")
+		.def(py::init<>())
+		.def("accept", &kit::MultiCameraSlicer::accept)
+		.def("doEveryTimeInterval",
+			 [](kit::MultiCameraSlicer &self, const std::string &name, 
+			 	const dv::Duration &interval, std::function<void(const kit::MultiCameraData &)> callback){
+					return self.doEveryTimeInterval(name, interval, std::move(callback));
+			 })
+		.def("doEveryTimeInterval",
+			 [](kit::MultiCameraSlicer &self, const std::string &name, 
+			 	const dv::Duration &interval, std::function<void(const dv::TimeWindow &, const kit::MultiCameraData &)> callback){
+					return self.doEveryTimeInterval(name, interval, std::move(callback));
+			 })
+		.def("doEveryTimeInterval",
+			 [](kit::MultiCameraSlicer &self, const std::string &name, const dv::Duration &interval, const dv::Duration &stride,
+			 	std::function<void(const dv::TimeWindow &, const kit::MultiCameraData &)> callback){
+					return self.doEveryTimeInterval(name, interval, stride, std::move(callback));
+			 })
+		.def("hasJob", &kit::MultiCameraSlicer::hasJob)
+		.def("removeJob", &kit::MultiCameraSlicer::removeJob);
+
+	m.attr("StereoCameraSlicer") = m.attr("MultiCameraSlicer");
+
+	py::class_<kit::PlannedSlice>(m, "PlannedSlice")
+		.def(py::init<>())
+		.def_readonly("timeWindow", &kit::PlannedSlice::timeWindow)
+		.def_readonly("start", &kit::PlannedSlice::start)
+		.def_readonly("length", &kit::PlannedSlice::length);
+
+	py::class_<kit::SlicePlan> slicePlan(m, "SlicePlan");
+
+	py::enum_<kit::SlicePlan::SliceType>(slicePlan, "SliceType")
+		.value("NUMBER", kit::SlicePlan::SliceType::NUMBER)
+		.value("TIME", kit::SlicePlan::SliceType::TIME);
+
+	slicePlan
+		.def(py::init<>())
+		.def_readonly("type", &kit::SlicePlan::type)
+		.def_readonly("reference", &kit::SlicePlan::reference)
+		.def_readonly("windows", &kit::SlicePlan::windows)
+		.def("__len__", &kit::SlicePlan::size)
+		.def("__getitem__", 
+			 [](const kit::SlicePlan &self, const size_t index) {
+				if (index >= self.size()) {
+					throw py::index_error();
+				}
+				return self[index];
+			 })
+		.def("materialize", &kit::SlicePlan::materialize<kit::MonoCameraData>, "data"_a, "index"_a,
+			 py::call_guard<py::gil_scoped_release>());
+
+	m.def("planSlices",
+		  [](const kit::MonoCameraData &data, const std::string &name, const size_t n, const size_t stride) {
+				return kit::planSlices(data, name, n, stride);
+		  }, "data"_a, "name"_a, "n"_a, "stride"_a, py::call_guard<py::gil_scoped_release>());
+	m.def("planSlices",
+		  [](const kit::MonoCameraData &data, const std::string &name, const size_t n) {
+				return kit::planSlices(data, name, n);
+		  }, "data"_a, "name"_a, "n"_a, py::call_guard<py::gil_scoped_release>());
+	m.def("planSlices",
+		  [](const kit::MonoCameraData &data, const std::string &name, const dv::Duration &interval, const dv::Duration &stride) {
+				return kit::planSlices(data, name, interval, stride);
+		  }, "data"_a, "name"_a, "interval"_a, "stride"_a, py::call_guard<py::gil_scoped_release>());
+	m.def("planSlices",
+		  [](const kit::MonoCameraData &data, const std::string &name, const dv::Duration &interval) {
+				return kit::planSlices(data, name, interval);
+		  }, "data"_a, "name"_a, "interval"_a, py::call_guard<py::gil_scoped_release>());
 
 	auto m_io = m.def_submodule("io");
 
+	py::class_<kit::io::ParallelReadConfig>(m_io, "ParallelReadConfig")
+		.def(py::init<>())
+		.def_readwrite("numThreads", &kit::io::ParallelReadConfig::numThreads)
+		.def_readwrite("prefetchDepth", &kit::io::ParallelReadConfig::prefetchDepth)
+		.def_readwrite("segmentDuration", &kit::io::ParallelReadConfig::segmentDuration);
+
+	// The region of interest is exposed as an (x, y, width, height) tuple
+	py::class_<kit::io::ReadOptions>(m_io, "ReadOptions")
+		.def(py::init<>())
+		.def_readwrite("events", &kit::io::ReadOptions::events)
+		.def_readwrite("frames", &kit::io::ReadOptions::frames)
+		.def_readwrite("imus", &kit::io::ReadOptions::imus)
+		.def_readwrite("triggers", &kit::io::ReadOptions::triggers)
+		.def_property("roi",
+			 [](const kit::io::ReadOptions &self) -> std::optional<std::tuple<int, int, int, int>> {
+				if (!self.roi.has_value()) {
+					return std::nullopt;
+				}
+				return std::make_tuple(self.roi->x, self.roi->y, self.roi->width, self.roi->height);
+			 },
+			 [](kit::io::ReadOptions &self, const std::optional<std::tuple<int, int, int, int>> &roi) {
+				if (!roi.has_value()) {
+					self.roi = std::nullopt;
+					return;
+				}
+				const auto [x, y, width, height] = *roi;
+				self.roi = cv::Rect(x, y, width, height);
+			 })
+		.def_readwrite("polarity", &kit::io::ReadOptions::polarity)
+		.def_readwrite("startTime", &kit::io::ReadOptions::startTime)
+		.def_readwrite("endTime", &kit::io::ReadOptions::endTime);
+
 	py::class_<kit::io::MonoCameraReader>(m_io, "MonoCameraReader")
-		.def(py::init<const fs::path &>())
-		.def("loadData", &kit::io::MonoCameraReader::loadData)
+		.def(py::init<const fs::path &, const kit::io::ReadOptions &>(), "path"_a,
+			 "options"_a = kit::io::ReadOptions())
+		.def("loadData", 
+			 [](kit::io::MonoCameraReader &self) {
+				return self.loadData();
+			 }, py::call_guard<py::gil_scoped_release>())
+		.def("loadData", 
+			 [](kit::io::MonoCameraReader &self, const kit::io::ParallelReadConfig &config) {
+				return self.loadData(config);
+			 }, "config"_a, py::call_guard<py::gil_scoped_release>())
+		.def("next",
+			 [](kit::io::MonoCameraReader &self, const size_t maxEvents) {
+				return self.next(maxEvents);
+			 }, "maxEvents"_a, py::call_guard<py::gil_scoped_release>())
+		.def("next",
+			 [](kit::io::MonoCameraReader &self, const dv::Duration &maxDuration) {
+				return self.next(maxDuration);
+			 }, "maxDuration"_a, py::call_guard<py::gil_scoped_release>())
+		.def("loadRange", &kit::io::MonoCameraReader::loadRange, "startTime"_a, "endTime"_a,
+			 py::call_guard<py::gil_scoped_release>())
+		.def("seek", &kit::io::MonoCameraReader::seek, "time"_a)
+		.def("getTimeRange", &kit::io::MonoCameraReader::getTimeRange)
+		.def("rewind", &kit::io::MonoCameraReader::rewind)
 		.def("getResolution", &kit::io::MonoCameraReader::getResolution)
 		.def("getEventResolution", &kit::io::MonoCameraReader::getEventResolution)
 		.def("getFrameResolution", &kit::io::MonoCameraReader::getFrameResolution);
 
+	py::class_<kit::io::evt::RawReader>(m_io, "RawReader")
+		.def(py::init<const fs::path &, const size_t>(), "path"_a, "chunkSize"_a = 16 * 1024 * 1024)
+		.def("next", &kit::io::evt::RawReader::next, py::call_guard<py::gil_scoped_release>())
+		.def("readAll", &kit::io::evt::RawReader::readAll, py::call_guard<py::gil_scoped_release>())
+		.def("getResolution", &kit::io::evt::RawReader::getResolution);
+
+	py::enum_<dv::CompressionType>(m_io, "CompressionType", py::module_local())
+		.value("NONE", dv::CompressionType::NONE)
+		.value("LZ4", dv::CompressionType::LZ4)
+		.value("LZ4_HIGH", dv::CompressionType::LZ4_HIGH)
+		.value("ZSTD", dv::CompressionType::ZSTD)
+		.value("ZSTD_HIGH", dv::CompressionType::ZSTD_HIGH);
+
+	py::class_<kit::io::WriteConfig>(m_io, "WriteConfig")
+		.def(py::init<>())
+		.def_readwrite("cameraName", &kit::io::WriteConfig::cameraName)
+		.def_readwrite("compression", &kit::io::WriteConfig::compression);
+
 	py::class_<kit::io::MonoCameraWriter>(m_io, "MonoCameraWriter")
-		.def(py::init<const fs::path &, const cv::Size &>())
-		.def("writeData", &kit::io::MonoCameraWriter::writeData);
+		.def(py::init<const fs::path &, const cv::Size &, const kit::io::WriteConfig &>(), "path"_a, "resolution"_a,
+			 "config"_a = kit::io::WriteConfig())
+		.def("writeData", &kit::io::MonoCameraWriter::writeData, py::call_guard<py::gil_scoped_release>())
+		.def("append", &kit::io::MonoCameraWriter::append, "chunk"_a, py::call_guard<py::gil_scoped_release>())
+		.def("close", &kit::io::MonoCameraWriter::close, py::call_guard<py::gil_scoped_release>())
+		.def("canAppend", &kit::io::MonoCameraWriter::canAppend);
+
+	py::class_<kit::io::AsyncMonoCameraWriter>(m_io, "AsyncMonoCameraWriter")
+		.def(py::init<const fs::path &, const cv::Size &, size_t, const kit::io::WriteConfig &>(), "path"_a,
+			 "resolution"_a, "queueCapacity"_a = 64, "config"_a = kit::io::WriteConfig())
+		.def("append", &kit::io::AsyncMonoCameraWriter::append, "chunk"_a, py::call_guard<py::gil_scoped_release>())
+		.def("tryAppend", &kit::io::AsyncMonoCameraWriter::tryAppend, "chunk"_a)
+		.def("close", &kit::io::AsyncMonoCameraWriter::close, py::call_guard<py::gil_scoped_release>())
+		.def("pending", &kit::io::AsyncMonoCameraWriter::pending);
+
+	py::class_<kit::io::RecorderConfig>(m_io, "RecorderConfig")
+		.def(py::init<>())
+		.def_readwrite("queueCapacity", &kit::io::RecorderConfig::queueCapacity)
+		.def_readwrite("flushInterval", &kit::io::RecorderConfig::flushInterval)
+		.def_readwrite("bufferCapacity", &kit::io::RecorderConfig::bufferCapacity)
+		.def_readwrite("pollInterval", &kit::io::RecorderConfig::pollInterval)
+		.def_readwrite("writeConfig", &kit::io::RecorderConfig::writeConfig);
+
+	py::class_<kit::io::RecorderStatistics>(m_io, "RecorderStatistics")
+		.def_readonly("received", &kit::io::RecorderStatistics::received)
+		.def_readonly("dropped", &kit::io::RecorderStatistics::dropped)
+		.def_readonly("flushes", &kit::io::RecorderStatistics::flushes)
+		.def_readonly("lastLatency", &kit::io::RecorderStatistics::lastLatency)
+		.def_readonly("maxLatency", &kit::io::RecorderStatistics::maxLatency)
+		.def_readonly("meanLatency", &kit::io::RecorderStatistics::meanLatency);
+
+	py::class_<kit::io::MonoCameraRecorder>(m_io, "MonoCameraRecorder")
+		.def(py::init<const fs::path &, const cv::Size &, const kit::io::RecorderConfig &>(), "path"_a, "resolution"_a,
+			 "config"_a = kit::io::RecorderConfig())
+		.def("push", &kit::io::MonoCameraRecorder::push, "chunk"_a)
+		.def("stop", &kit::io::MonoCameraRecorder::stop, py::call_guard<py::gil_scoped_release>())
+		.def("statistics", &kit::io::MonoCameraRecorder::statistics);
+
+	py::class_<kit::io::DatasetConfig>(m_io, "DatasetConfig")
+		.def(py::init<>())
+		.def_readwrite("numThreads", &kit::io::DatasetConfig::numThreads)
+		.def_readwrite("cacheCapacity", &kit::io::DatasetConfig::cacheCapacity)
+		.def_readwrite("prefetchDepth", &kit::io::DatasetConfig::prefetchDepth)
+		.def_readwrite("indexFile", &kit::io::DatasetConfig::indexFile)
+		.def_readwrite("recursive", &kit::io::DatasetConfig::recursive);
+
+	py::class_<kit::io::RecordingInfo>(m_io, "RecordingInfo")
+		.def_readonly("path", &kit::io::RecordingInfo::path)
+		.def_readonly("fileSize", &kit::io::RecordingInfo::fileSize)
+		.def_readonly("startTime", &kit::io::RecordingInfo::startTime)
+		.def_readonly("endTime", &kit::io::RecordingInfo::endTime)
+		.def_readonly("events", &kit::io::RecordingInfo::events)
+		.def_readonly("frames", &kit::io::RecordingInfo::frames)
+		.def_readonly("imus", &kit::io::RecordingInfo::imus)
+		.def_readonly("triggers", &kit::io::RecordingInfo::triggers)
+		.def_readonly("eventResolution", &kit::io::RecordingInfo::eventResolution)
+		.def_readonly("frameResolution", &kit::io::RecordingInfo::frameResolution)
+		.def("duration", &kit::io::RecordingInfo::duration);
+
+	py::class_<kit::io::DatasetSample>(m_io, "DatasetSample")
+		.def(py::init([](const size_t recording, const int64_t startTime, const int64_t endTime) {
+			return kit::io::DatasetSample{recording, startTime, endTime};
+		}), "recording"_a, "startTime"_a, "endTime"_a)
+		.def_readwrite("recording", &kit::io::DatasetSample::recording)
+		.def_readwrite("startTime", &kit::io::DatasetSample::startTime)
+		.def_readwrite("endTime", &kit::io::DatasetSample::endTime);
+
+	py::class_<kit::io::DatasetStatistics>(m_io, "DatasetStatistics")
+		.def_readonly("hits", &kit::io::DatasetStatistics::hits)
+		.def_readonly("misses", &kit::io::DatasetStatistics::misses)
+		.def_readonly("evictions", &kit::io::DatasetStatistics::evictions);
+
+	// Samples are handed out as copies, which share their shards with the cached data
+	py::class_<kit::io::DatasetReader>(m_io, "DatasetReader")
+		.def(py::init<const fs::path &, const kit::io::DatasetConfig &>(), "directory"_a,
+			 "config"_a = kit::io::DatasetConfig(), py::call_guard<py::gil_scoped_release>())
+		.def("recordings", &kit::io::DatasetReader::recordings)
+		.def("skipped", &kit::io::DatasetReader::skipped)
+		.def("__len__", &kit::io::DatasetReader::size)
+		.def("randomSamples", &kit::io::DatasetReader::randomSamples, "count"_a, "duration"_a,
+			 "seed"_a = std::random_device()())
+		.def("prefetch", &kit::io::DatasetReader::prefetch, "sample"_a)
+		.def("load",
+			 [](kit::io::DatasetReader &self, const kit::io::DatasetSample &sample) {
+				return kit::MonoCameraData(*self.load(sample));
+			 }, "sample"_a, py::call_guard<py::gil_scoped_release>())
+		.def("schedule", &kit::io::DatasetReader::schedule, "samples"_a)
+		.def("next",
+			 [](kit::io::DatasetReader &self) -> std::optional<std::pair<kit::io::DatasetSample, kit::MonoCameraData>> {
+				auto item = self.next();
+				if (!item.has_value()) {
+					return std::nullopt;
+				}
+				return std::make_pair(item->first, kit::MonoCameraData(*item->second));
+			 }, py::call_guard<py::gil_scoped_release>())
+		.def("statistics", &kit::io::DatasetReader::statistics);
+
+	// DataLoader workers export a window and release the object, the main process
+	// attaches it by name with unlink=True
+	auto m_shm = m_io.def_submodule("shm");
+
+	py::class_<kit::io::shm::SharedMemory, std::shared_ptr<kit::io::shm::SharedMemory>>(m_shm, "SharedMemory")
+		.def_property_readonly("name", &kit::io::shm::SharedMemory::name)
+		.def("size", &kit::io::shm::SharedMemory::size)
+		.def("release", &kit::io::shm::SharedMemory::release);
+
+	py::class_<kit::io::cache::Contents>(m_shm, "Contents")
+		.def_readonly("data", &kit::io::cache::Contents::data)
+		.def_readonly("eventResolution", &kit::io::cache::Contents::eventResolution)
+		.def_readonly("frameResolution", &kit::io::cache::Contents::frameResolution);
+
+	m_shm.def("exportData", &kit::io::shm::exportData, "data"_a, "eventResolution"_a = std::nullopt,
+		"frameResolution"_a = std::nullopt, "name"_a = "", py::call_guard<py::gil_scoped_release>());
+	m_shm.def("attach", &kit::io::shm::attach, "name"_a, "unlink"_a = false,
+		py::call_guard<py::gil_scoped_release>());
 
 	auto m_simulation = m.def_submodule("simulation");
 
@@ -7,6 +7,26 @@ from .tools import mp_player
 from .tools import go_player
 
 
+class _PlannedPackets(object):
+    """
+    Sequence of packets backed by a slice plan, each packet is sliced on access
+    """
+
+    def __init__(self, data, plan) -> None:
+        self._data = data
+        self._plan = plan
+
+    def __len__(self):
+        return len(self._plan)
+
+    def __getitem__(self, i):
+        if i < 0:
+            i += len(self._plan)
+        if i < 0 or i >= len(self._plan):
+            raise IndexError("packet index out of range")
+        return self._plan.materialize(self._data, i)
+
+
 class OfflineMonoCameraPlayer(object):
     def __init__(self, 
                  resolution: Tuple[int, int], 
@@ -32,12 +52,8 @@ class OfflineMonoCameraPlayer(object):
     def viewPerTimeInterval(self, data, 
                             reference: str = "events",
                             interval: timedelta = timedelta(milliseconds=33)):
-        # slice data
-        slicer, packets = kit.MonoCameraSlicer(), list()
-        slicer.doEveryTimeInterval(
-            reference, interval, lambda data: packets.append(data)
-        )
-        slicer.accept(data)
+        # plan windows, packets are sliced when they are drawn
+        packets = _PlannedPackets(data, kit.planSlices(data, reference, interval))
 
         # run
         self._run(
@@ -48,12 +64,8 @@ class OfflineMonoCameraPlayer(object):
     def viewPerNumberInterval(self, data, 
                               reference: str = "events",
                               interval: int = 15000):
-        # slice data
-        slicer, packets = kit.MonoCameraSlicer(), list()
-        slicer.doEveryNumberOfElements(
-            reference, interval, lambda data: packets.append(data)
-        )
-        slicer.accept(data)
+        # plan windows, packets are sliced when they are drawn
+        packets = _PlannedPackets(data, kit.planSlices(data, reference, interval))
         
         # run
         self._run(
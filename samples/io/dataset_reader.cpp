@@ -0,0 +1,43 @@
+#include <dv-toolkit/core/core.hpp>
+#include <dv-toolkit/io/dataset.hpp>
+
+#include <chrono>
+
+int main(int argc, char **argv) {
+    namespace kit = dv::toolkit;
+
+    // Enable literal time expression from the chrono library
+    using namespace std::chrono_literals;
+
+    // Index the directory, the index is reused by later runs
+    const fs::path directory = (argc > 1) ? fs::path(argv[1]) : fs::path("/path/to/dataset");
+    kit::io::DatasetConfig config;
+    config.cacheCapacity = 64;
+    config.prefetchDepth = 16;
+    kit::io::DatasetReader dataset(directory, config);
+
+    for (const auto &info : dataset.recordings()) {
+        std::cout << fmt::format("{}: {} bytes, {} us", info.path.string(), info.fileSize, info.duration()) << std::endl;
+    }
+    for (const auto &[path, error] : dataset.skipped()) {
+        std::cout << fmt::format("{}: skipped, {}", path.string(), error) << std::endl;
+    }
+
+    // One epoch of random 50 ms windows, loaded while the previous ones are consumed
+    dataset.schedule(dataset.randomSamples(1000, 50ms, 0));
+
+    const auto start = std::chrono::steady_clock::now();
+    size_t events = 0;
+    while (const auto item = dataset.next()) {
+        const auto &[sample, data] = *item;
+        // A training step would consume the sample here
+        events += data->events().size();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const auto statistics = dataset.statistics();
+    std::cout << fmt::format("{} events in {:.2f} s, {} cache hits, {} misses", events, elapsed.count(),
+        statistics.hits, statistics.misses) << std::endl;
+
+    return 0;
+}
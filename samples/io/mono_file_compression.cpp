@@ -0,0 +1,51 @@
+#include <dv-toolkit/core/core.hpp>
+#include <dv-toolkit/io/reader.hpp>
+#include <dv-toolkit/io/writer.hpp>
+
+#include <chrono>
+
+int main(int argc, char **argv) {
+    namespace kit = dv::toolkit;
+
+    // Load the recording to benchmark once, all codecs write the same data
+    const fs::path input = (argc > 1) ? fs::path(argv[1]) : fs::path("/path/to/aedat4");
+    kit::io::MonoCameraReader reader(input);
+    const kit::MonoCameraData data = reader.loadData();
+    const auto resolution = reader.getEventResolution().value_or(cv::Size(346, 260));
+
+    // Size of the uncompressed elements
+    size_t rawBytes = data.events().size() * sizeof(dv::Event) + data.imus().size() * sizeof(dv::IMU)
+                    + data.triggers().size() * sizeof(dv::Trigger);
+    for (const auto &frame : data.frames()) {
+        rawBytes += frame.image.total() * frame.image.elemSize();
+    }
+
+    const std::vector<std::pair<std::string, dv::CompressionType>> codecs = {
+        {"NONE",      dv::CompressionType::NONE},
+        {"LZ4",       dv::CompressionType::LZ4},
+        {"LZ4_HIGH",  dv::CompressionType::LZ4_HIGH},
+        {"ZSTD",      dv::CompressionType::ZSTD},
+        {"ZSTD_HIGH", dv::CompressionType::ZSTD_HIGH},
+    };
+
+    std::cout << fmt::format("{:<10} {:>12} {:>10}", "codec", "MB/s", "ratio") << std::endl;
+    for (const auto &[name, compression] : codecs) {
+        const fs::path output = fs::temp_directory_path() / fmt::format("compression_{}.aedat4", name);
+
+        kit::io::WriteConfig config;
+        config.compression = compression;
+
+        const auto start = std::chrono::steady_clock::now();
+        kit::io::MonoCameraWriter(output, resolution, config).writeData(data);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        const auto fileBytes = fs::file_size(output);
+        std::cout << fmt::format("{:<10} {:>12.1f} {:>10.2f}", name,
+            static_cast<double>(rawBytes) / 1e6 / elapsed.count(),
+            static_cast<double>(rawBytes) / static_cast<double>(fileBytes)) << std::endl;
+
+        fs::remove(output);
+    }
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include <dv-toolkit/io/evt.hpp>
+
+#include <chrono>
+
+int main(int argc, char **argv) {
+    namespace kit = dv::toolkit;
+
+    const std::filesystem::path input = (argc > 1) ? argv[1] : "/path/to/recording.raw";
+
+    // Decoder alone, into a warm buffer that already holds every event
+    {
+        const kit::io::MappedFile file(input);
+        const auto header = kit::io::evt::RawHeader::parse(file.view());
+        const char *data  = file.data() + header.dataOffset;
+        const size_t size = file.size() - header.dataOffset;
+
+        std::vector<dv::Event> events;
+        std::vector<dv::Trigger> triggers;
+        double best = 0.;
+        for (int repetition = 0; repetition < 3; repetition++) {
+            events.clear();
+            triggers.clear();
+
+            const auto start = std::chrono::steady_clock::now();
+            if (header.format == kit::io::evt::Format::EVT2) {
+                kit::io::evt::Evt2Decoder().decode(data, size / kit::io::evt::Evt2Decoder::wordSize, events, triggers);
+            } else {
+                kit::io::evt::Evt3Decoder().decode(data, size / kit::io::evt::Evt3Decoder::wordSize, events, triggers);
+            }
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::max(best, static_cast<double>(events.size()) / 1e6 / elapsed.count());
+        }
+        std::cout << fmt::format("{:<24} {:>10.1f} Mev/s", "decode loop", best) << std::endl;
+    }
+
+    std::cout << fmt::format("{:<24} {:>10} {:>10}", "chunk size", "stream", "readAll") << std::endl;
+    for (const size_t chunkSize : {256 * 1024, 1024 * 1024, 4 * 1024 * 1024, 16 * 1024 * 1024}) {
+        // Chunks dropped right away, their buffer is reused by the next one
+        size_t count     = 0;
+        auto start       = std::chrono::steady_clock::now();
+        kit::io::evt::RawReader stream(input, chunkSize);
+        while (const auto chunk = stream.next()) {
+            count += chunk->events().size();
+        }
+        const std::chrono::duration<double> streamed = std::chrono::steady_clock::now() - start;
+
+        // Chunks kept, every one of them is a fresh shard
+        start = std::chrono::steady_clock::now();
+        kit::io::evt::RawReader reader(input, chunkSize);
+        const auto data = reader.readAll();
+        const std::chrono::duration<double> loaded = std::chrono::steady_clock::now() - start;
+
+        std::cout << fmt::format("{:<24} {:>10.1f} {:>10.1f}", fmt::format("{} KB", chunkSize / 1024),
+            static_cast<double>(count) / 1e6 / streamed.count(),
+            static_cast<double>(data.events().size()) / 1e6 / loaded.count()) << std::endl;
+    }
+
+    return 0;
+}
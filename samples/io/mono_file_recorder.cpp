@@ -0,0 +1,52 @@
+#include <dv-toolkit/core/core.hpp>
+#include <dv-toolkit/io/recorder.hpp>
+
+#include <random>
+#include <thread>
+
+int main() {
+    namespace kit = dv::toolkit;
+
+    // Enable literal time expression from the chrono library
+    using namespace std::chrono_literals;
+
+    // Initialize resolution
+    const auto resolution = cv::Size(640, 480);
+
+    // Initialize recorder, buffers are written twice per second
+    kit::io::RecorderConfig config;
+    config.flushInterval = 500ms;
+    kit::io::MonoCameraRecorder recorder("/path/to/file.aedat4", resolution, config);
+
+    // Synthetic source producing a chunk of random events every millisecond,
+    // as a camera callback would, for five seconds
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<int16_t> x(0, static_cast<int16_t>(resolution.width - 1));
+    std::uniform_int_distribution<int16_t> y(0, static_cast<int16_t>(resolution.height - 1));
+    std::bernoulli_distribution polarity(0.5);
+
+    int64_t timestamp = dv::now();
+    for (int i = 0; i < 5000; i++) {
+        kit::MonoCameraData chunk;
+        kit::EventStorage events;
+        for (int j = 0; j < 1000; j++) {
+            events.emplace_back(timestamp + j, x(generator), y(generator), polarity(generator));
+        }
+        chunk["events"] = events;
+        timestamp += 1000;
+
+        // Never blocks, a full queue drops the chunk
+        recorder.push(std::move(chunk));
+        std::this_thread::sleep_for(1ms);
+    }
+
+    // Write the remaining buffers and finalize the file
+    recorder.stop();
+
+    const auto statistics = recorder.statistics();
+    std::cout << fmt::format("received {} chunks, dropped {}, {} flushes taking {} on average and {} at most",
+        statistics.received, statistics.dropped, statistics.flushes, statistics.meanLatency, statistics.maxLatency)
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+#include <dv-toolkit/core/slicer.hpp>
+#include <dv-toolkit/io/reader.hpp>
+
+int main() {
+    namespace kit = dv::toolkit;
+
+    // Enable literal time expression from the chrono library
+    using namespace std::chrono_literals;
+
+    // Initialize reader
+    kit::io::MonoCameraReader reader("/path/to/aedat4");
+
+    // Initialize slicer, windows may span several chunks
+    kit::MonoCameraSlicer slicer;
+    slicer.doEveryTimeInterval("events", 33ms, [](const kit::MonoCameraData &mono) {
+        std::cout << mono.events() << std::endl;
+    });
+
+    // Stream the recording in chunks of 100ms, only the current chunk and the
+    // data of unfinished windows are held in memory. reader.next(100000) would 
+    // return chunks of at most 100000 events instead.
+    while (const auto chunk = reader.next(100ms)) {
+        slicer.accept(*chunk);
+    }
+
+    return 0;
+}
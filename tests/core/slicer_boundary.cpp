@@ -0,0 +1,120 @@
+#include <dv-toolkit/core/slicer.hpp>
+
+#include <cstdlib>
+#include <iostream>
+
+namespace kit = dv::toolkit;
+
+namespace {
+
+int failures = 0;
+
+void expect(const bool condition, const std::string &message) {
+	if (!condition) {
+		std::cerr << "FAILED: " << message << std::endl;
+		failures++;
+	}
+}
+
+kit::MonoCameraData makeEvents(const int64_t from, const int64_t to) {
+	kit::EventStorage events;
+	for (int64_t timestamp = from; timestamp < to; timestamp++) {
+		events.emplace_back(timestamp, 0, 0, true);
+	}
+
+	kit::MonoCameraData data;
+	data["events"] = events;
+	return data;
+}
+
+} // namespace
+
+/**
+ * Windows of bounded jobs have to cover reference data that was accepted
+ * before the boundary element delimiting them.
+ */
+void testExposureAfterEvents() {
+	kit::MonoCameraSlicer slicer;
+
+	size_t windows = 0;
+	size_t events  = 0;
+	slicer.doEveryFrameExposure("events", "frames", [&](const dv::TimeWindow &window, const kit::MonoCameraData &data) {
+		windows++;
+		events += data.events().size();
+		expect(window.startTime == 10 && window.endTime == 60, "exposure window spans [10, 60)");
+	});
+
+	slicer.accept(makeEvents(0, 100));
+
+	kit::FrameStorage frames;
+	frames.emplace_back(10, dv::Duration(50), 0, 0, cv::Mat(), dv::FrameSource::SENSOR);
+
+	kit::MonoCameraData data;
+	data["frames"] = frames;
+	slicer.accept(data);
+
+	expect(windows == 1, "one exposure window emitted");
+	expect(events == 50, "exposure window holds the events accepted before the frame");
+}
+
+void testBoundaryAfterEvents() {
+	kit::MonoCameraSlicer slicer;
+
+	size_t windows = 0;
+	size_t events  = 0;
+	slicer.doEveryBoundaryInterval("events", "triggers", [&](const dv::TimeWindow &, const kit::MonoCameraData &data) {
+		windows++;
+		events += data.events().size();
+	});
+
+	// Events arrive in several chunks ahead of the triggers delimiting them
+	slicer.accept(makeEvents(0, 40));
+	slicer.accept(makeEvents(40, 100));
+
+	kit::TriggerStorage triggers;
+	triggers.emplace_back(20, dv::TriggerType::EXTERNAL_SIGNAL_RISING_EDGE);
+	triggers.emplace_back(70, dv::TriggerType::EXTERNAL_SIGNAL_RISING_EDGE);
+
+	kit::MonoCameraData data;
+	data["triggers"] = triggers;
+	slicer.accept(data);
+
+	expect(windows == 1, "one boundary window emitted");
+	expect(events == 50, "boundary window holds the events accepted before the triggers");
+}
+
+/**
+ * Until the first boundary element arrives, a bounded job only keeps the last
+ * `maxLookback` of the other streams.
+ */
+void testLookbackBeforeFirstBoundary() {
+	kit::MonoCameraSlicer slicer;
+
+	size_t events = 0;
+	const int job = slicer.doEveryFrameExposure("events", "frames", [&](const kit::MonoCameraData &data) {
+		events += data.events().size();
+	});
+	slicer.modifyMaxLookback(job, dv::Duration(100));
+
+	for (int64_t chunk = 0; chunk < 10; chunk++) {
+		slicer.accept(makeEvents(chunk * 100, chunk * 100 + 100));
+	}
+
+	kit::FrameStorage frames;
+	frames.emplace_back(0, dv::Duration(950), 0, 0, cv::Mat(), dv::FrameSource::SENSOR);
+
+	kit::MonoCameraData data;
+	data["frames"] = frames;
+	slicer.accept(data);
+
+	// Events before 899 were released, 100 us before the last one accepted
+	expect(events == 51, "exposure window limited to the lookback before the first frame");
+}
+
+int main() {
+	testExposureAfterEvents();
+	testBoundaryAfterEvents();
+	testLookbackBeforeFirstBoundary();
+
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
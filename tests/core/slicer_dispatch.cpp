@@ -0,0 +1,222 @@
+#include <dv-toolkit/core/slicer.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace kit = dv::toolkit;
+
+namespace {
+
+int failures = 0;
+
+void expect(const bool condition, const std::string &message) {
+	if (!condition) {
+		std::cerr << "FAILED: " << message << std::endl;
+		failures++;
+	}
+}
+
+kit::MonoCameraData makeEvents(const int64_t from, const int64_t to) {
+	kit::EventStorage events;
+	for (int64_t timestamp = from; timestamp < to; timestamp++) {
+		events.emplace_back(timestamp, 0, 0, true);
+	}
+
+	kit::MonoCameraData data;
+	data["events"] = events;
+	return data;
+}
+
+/** Windows delivered to a callback, in delivery order */
+struct Delivered {
+	std::mutex mutex;
+	std::vector<std::pair<int64_t, int64_t>> windows;
+	size_t events = 0;
+
+	void add(const kit::MonoCameraData &data) {
+		std::lock_guard<std::mutex> lock(mutex);
+		windows.emplace_back(data.events().getLowestTime(), data.events().getHighestTime());
+		events += data.events().size();
+	}
+
+	[[nodiscard]] bool ordered() {
+		std::lock_guard<std::mutex> lock(mutex);
+		for (size_t i = 1; i < windows.size(); i++) {
+			if (windows[i].first <= windows[i - 1].second) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+} // namespace
+
+/**
+ * Windows of every job reach their callback in emission order, whatever the
+ * number of workers.
+ */
+void testOrderWithinJob() {
+	kit::MonoCameraSlicer slicer;
+
+	Delivered first;
+	Delivered second;
+	const int firstJob = slicer.doEveryNumberOfElements("events", 100, [&](const kit::MonoCameraData &data) {
+		first.add(data);
+	});
+	slicer.doEveryNumberOfElements("events", 30, [&](const kit::MonoCameraData &data) {
+		second.add(data);
+	});
+	slicer.enableAsyncDispatch(4, 4, kit::BackpressurePolicy::BLOCK);
+
+	for (int64_t chunk = 0; chunk < 50; chunk++) {
+		slicer.accept(makeEvents(chunk * 100, chunk * 100 + 100));
+	}
+	slicer.flush();
+
+	expect(first.windows.size() == 50 && first.events == 5000, "every window of the first job delivered");
+	expect(second.windows.size() == 166, "every window of the second job delivered");
+	expect(first.ordered() && second.ordered(), "windows of a job delivered in order");
+
+	const auto statistics = slicer.getJobStatistics(firstJob);
+	expect(statistics.has_value() && statistics->dispatched == 50, "every window counted as dispatched");
+	expect(statistics->queueDepth == 0 && statistics->maxQueueDepth <= 4, "queue depth bounded by the capacity");
+}
+
+/**
+ * BLOCK waits for room in the queue, a slow callback loses no window.
+ */
+void testBlock() {
+	kit::MonoCameraSlicer slicer;
+
+	Delivered delivered;
+	const int job = slicer.doEveryNumberOfElements("events", 100, [&](const kit::MonoCameraData &data) {
+		std::this_thread::sleep_for(std::chrono::microseconds(500));
+		delivered.add(data);
+	});
+	slicer.enableAsyncDispatch(2, 2, kit::BackpressurePolicy::BLOCK);
+
+	for (int64_t chunk = 0; chunk < 20; chunk++) {
+		slicer.accept(makeEvents(chunk * 100, chunk * 100 + 100));
+	}
+	slicer.flush();
+
+	const auto statistics = slicer.getJobStatistics(job);
+	expect(delivered.windows.size() == 20 && delivered.ordered(), "blocking dispatch delivers every window in order");
+	expect(statistics->dropped == 0 && statistics->coalesced == 0, "blocking dispatch neither drops nor merges");
+	expect(statistics->maxQueueDepth <= 2, "blocking dispatch never exceeds the capacity");
+}
+
+/**
+ * DROP_OLDEST discards pending windows while the callback is stalled, the
+ * newest ones are delivered.
+ */
+void testDropOldest() {
+	kit::MonoCameraSlicer slicer;
+
+	std::atomic<bool> released{false};
+	Delivered delivered;
+	const int job = slicer.doEveryNumberOfElements("events", 100, [&](const kit::MonoCameraData &data) {
+		while (!released) {
+			std::this_thread::yield();
+		}
+		delivered.add(data);
+	});
+	slicer.enableAsyncDispatch(1, 2, kit::BackpressurePolicy::DROP_OLDEST);
+
+	for (int64_t chunk = 0; chunk < 20; chunk++) {
+		slicer.accept(makeEvents(chunk * 100, chunk * 100 + 100));
+	}
+	released = true;
+	slicer.flush();
+
+	const auto statistics = slicer.getJobStatistics(job);
+	expect(statistics->dropped > 0, "stalled callback makes windows drop");
+	expect(statistics->dispatched + statistics->dropped == 20, "every window either delivered or dropped");
+	expect(delivered.ordered(), "remaining windows delivered in order");
+	expect(!delivered.windows.empty() && delivered.windows.back().second == 1999, "newest window delivered");
+}
+
+/**
+ * COALESCE merges windows while the callback is stalled, back-to-back windows
+ * still deliver every element exactly once.
+ */
+void testCoalesce() {
+	kit::MonoCameraSlicer slicer;
+
+	std::atomic<bool> released{false};
+	Delivered delivered;
+	bool unique = true;
+	const int job = slicer.doEveryNumberOfElements("events", 100, [&](const kit::MonoCameraData &data) {
+		while (!released) {
+			std::this_thread::yield();
+		}
+		int64_t previous = -1;
+		for (const auto &event : data.events()) {
+			unique   = unique && event.timestamp() > previous;
+			previous = event.timestamp();
+		}
+		delivered.add(data);
+	});
+	slicer.enableAsyncDispatch(1, 2, kit::BackpressurePolicy::COALESCE);
+
+	for (int64_t chunk = 0; chunk < 20; chunk++) {
+		slicer.accept(makeEvents(chunk * 100, chunk * 100 + 100));
+	}
+	released = true;
+	slicer.flush();
+
+	const auto statistics = slicer.getJobStatistics(job);
+	expect(statistics->coalesced > 0, "stalled callback makes windows merge");
+	expect(statistics->dispatched + statistics->coalesced == 20, "every window either delivered or merged");
+	expect(delivered.events == 2000 && unique, "merged windows hold every element exactly once");
+	expect(delivered.ordered(), "merged windows delivered in order");
+}
+
+/**
+ * The error of an asynchronous callback is rethrown to the accepting thread,
+ * the slicer keeps working afterwards.
+ */
+void testThrowingCallback() {
+	kit::MonoCameraSlicer slicer;
+
+	std::atomic<size_t> calls{0};
+	slicer.doEveryNumberOfElements("events", 100, [&](const kit::MonoCameraData &) {
+		if (calls++ == 2) {
+			throw std::runtime_error("callback failed");
+		}
+	});
+	slicer.enableAsyncDispatch(2, 4, kit::BackpressurePolicy::BLOCK);
+
+	bool rethrown = false;
+	try {
+		for (int64_t chunk = 0; chunk < 10; chunk++) {
+			slicer.accept(makeEvents(chunk * 100, chunk * 100 + 100));
+		}
+		slicer.flush();
+	} catch (const std::runtime_error &error) {
+		rethrown = std::string(error.what()) == "callback failed";
+	}
+	expect(rethrown, "callback error rethrown by accept or flush");
+
+	// The error is reported once, later windows are delivered again
+	slicer.flush();
+	const size_t before = calls;
+	slicer.accept(makeEvents(5000, 5100));
+	slicer.flush();
+	expect(calls == before + 1, "windows after the error are delivered");
+	slicer.disableAsyncDispatch();
+}
+
+int main() {
+	testOrderWithinJob();
+	testBlock();
+	testDropOldest();
+	testCoalesce();
+	testThrowingCallback();
+
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,132 @@
+#include <dv-toolkit/io/reader.hpp>
+#include <dv-toolkit/io/recorder.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+namespace kit = dv::toolkit;
+
+namespace {
+
+int failures = 0;
+
+void expect(const bool condition, const std::string &message) {
+	if (!condition) {
+		std::cerr << "FAILED: " << message << std::endl;
+		failures++;
+	}
+}
+
+const cv::Size resolution(64, 48);
+
+/** Chunk of a synthetic source, one event per microsecond of [from, to) */
+kit::MonoCameraData makeChunk(const int64_t from, const int64_t to) {
+	kit::EventStorage events;
+	for (int64_t timestamp = from; timestamp < to; timestamp++) {
+		events.emplace_back(timestamp, static_cast<int16_t>(timestamp % resolution.width),
+			static_cast<int16_t>(timestamp % resolution.height), timestamp % 2 == 0);
+	}
+
+	kit::MonoCameraData chunk;
+	chunk["events"] = events;
+	return chunk;
+}
+
+fs::path outputPath(const std::string &name) {
+	return fs::temp_directory_path() / ("dv-toolkit-recorder-" + name + ".aedat4");
+}
+
+/** Events of the written file, which have to be in time order */
+size_t writtenEvents(const fs::path &path) {
+	const auto data = kit::io::MonoCameraReader(path).loadData();
+	int64_t previous = std::numeric_limits<int64_t>::min();
+	for (const auto &event : data.events()) {
+		expect(event.timestamp() >= previous, "written events in time order");
+		previous = event.timestamp();
+	}
+	return data.events().size();
+}
+
+} // namespace
+
+/**
+ * Every chunk of a synthetic source reaches the file when the queue is large
+ * enough for the source.
+ */
+void testSyntheticSource() {
+	const auto path = outputPath("source");
+	kit::io::RecorderConfig config;
+	config.queueCapacity = 512;
+	config.flushInterval = dv::Duration(1000);
+
+	kit::io::MonoCameraRecorder recorder(path, resolution, config);
+	for (int64_t chunk = 0; chunk < 200; chunk++) {
+		expect(recorder.push(makeChunk(chunk * 100, chunk * 100 + 100)), "chunk accepted by the queue");
+	}
+	recorder.stop();
+
+	const auto statistics = recorder.statistics();
+	expect(statistics.received == 200 && statistics.dropped == 0, "every chunk received, none dropped");
+	expect(statistics.flushes > 0, "buffers flushed");
+	expect(writtenEvents(path) == 20000, "every event written");
+	fs::remove(path);
+}
+
+/**
+ * A chunk going back in time is dropped even when the chunks it overlaps were
+ * already handed to the flush thread.
+ */
+void testOutOfOrderAfterHandOver() {
+	const auto path = outputPath("order");
+	kit::io::RecorderConfig config;
+	config.flushInterval = dv::Duration(0);
+
+	kit::io::MonoCameraRecorder recorder(path, resolution, config);
+	recorder.push(makeChunk(0, 100));
+	while (recorder.statistics().flushes == 0) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	recorder.push(makeChunk(50, 150));
+	recorder.push(makeChunk(100, 200));
+	recorder.stop();
+
+	const auto statistics = recorder.statistics();
+	expect(statistics.received == 2 && statistics.dropped == 1, "out of order chunk dropped");
+	expect(writtenEvents(path) == 200, "recording continues after the dropped chunk");
+	fs::remove(path);
+}
+
+/**
+ * Buffers never collect more than their capacity, whatever the flush interval.
+ */
+void testBufferCapacity() {
+	const auto path = outputPath("capacity");
+	kit::io::RecorderConfig config;
+	config.queueCapacity  = 16;
+	config.bufferCapacity = 4;
+	config.flushInterval  = dv::Duration(10000000);
+
+	kit::io::MonoCameraRecorder recorder(path, resolution, config);
+	size_t pushed = 0;
+	for (int64_t chunk = 0; chunk < 400; chunk++) {
+		pushed += recorder.push(makeChunk(chunk * 100, chunk * 100 + 100)) ? 1 : 0;
+	}
+	recorder.stop();
+
+	const auto statistics = recorder.statistics();
+	expect(statistics.received == pushed, "every queued chunk collected");
+	expect(statistics.received + statistics.dropped == 400, "every chunk either received or dropped");
+	expect(statistics.flushes >= (statistics.received + 3) / 4, "buffers hold at most their capacity");
+	expect(writtenEvents(path) == statistics.received * 100, "received chunks written");
+	fs::remove(path);
+}
+
+int main() {
+	testSyntheticSource();
+	testOutOfOrderAfterHandOver();
+	testBufferCapacity();
+
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}